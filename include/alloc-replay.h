@@ -0,0 +1,124 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the allocator trace replay harness (alloc-replay.c).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_ALLOC_REPLAY_H
+#define CODE_ALLOC_REPLAY_H
+
+#include <stddef.h>
+
+/*
+ * Common interface over the allocators, so any of them can replay the same
+ * trace. Engines are looked up by name: "buddy", "magazine", "slab",
+ * "lock-free" and "malloc".
+ */
+typedef struct {
+    const char *name;
+    size_t stateSize;
+    int (*init)(void *state, size_t arenaSize);
+    void *(*alloc)(void *state, size_t size);
+    int (*free)(void *state, void *pointer);
+    void *(*realloc)(void *state, void *pointer, size_t size); // NULL: allocate, copy and free
+    size_t (*blockSize)(void *state, void *pointer); // Bytes the allocator reserved for the block
+    // Bytes taken from the arena (or the system), and the free bytes and largest free block
+    // left in it; largestFree is 0 if the engine cannot tell
+    void (*usage)(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree);
+    void (*destroy)(void *state);
+} AllocatorOps;
+
+extern const AllocatorOps *const allocatorEngines[];
+extern const int allocatorEngineCount;
+const AllocatorOps *findAllocatorEngine(const char *name);
+
+// One trace event. A text trace has one per line: "a <id> <size>", "r <id> <size>" or "f <id>".
+// As with realloc(), "r <id> 0" on a live block frees it.
+typedef struct {
+    char op; // 'a', 'r' or 'f'
+    int id; // Names the block across events, 0 to maxId
+    size_t size;
+} AllocEvent;
+
+typedef struct {
+    AllocEvent *events;
+    long long length;
+    int maxId;
+} AllocTrace;
+
+#define SIZE_UNIFORM 0
+#define SIZE_POWER_LAW 1 // Density proportional to 1/size between minSize and maxSize
+#define SIZE_BIMODAL 2 // 90% from [minSize, 4 minSize], 10% from [maxSize / 4, maxSize]
+
+typedef struct {
+    int distribution;
+    size_t minSize;
+    size_t maxSize;
+    int maxLive; // Blocks live at once
+    double reallocRate; // Share of the events on a live block that are reallocs, not frees
+    long long length;
+    unsigned seed;
+} AllocTraceConfig;
+
+int generateAllocTrace(const AllocTraceConfig *config, AllocTrace *trace);
+int loadAllocTrace(const char *path, AllocTrace *trace);
+int writeAllocTrace(const char *path, const AllocTrace *trace);
+void freeAllocTrace(AllocTrace *trace);
+
+typedef struct {
+    long long event;
+    size_t requested; // Bytes asked for by the live blocks
+    size_t reserved; // Bytes the allocator reserved for them
+    size_t footprint;
+    double internal; // 1 - requested / reserved
+    double external; // 1 - largest free block / free bytes, -1 if unknown
+} AllocSample;
+
+typedef struct {
+    const char *engine;
+    double opsPerSecond;
+    double p50, p99, p999, maxLatency; // Nanoseconds per event
+    size_t peakFootprint; // Over the samples
+    size_t peakReserved;
+    long long failures; // Allocations that returned NULL
+    AllocSample *samples;
+    int sampleCount;
+} AllocReplayResult;
+
+// Replay a trace twice: once for throughput, once timing every event. Samples are taken
+// every sampleEvery events of the second run. Returns 0 on success and -1 on error.
+int replayAllocTrace(const AllocatorOps *ops, const AllocTrace *trace, size_t arenaSize, int sampleEvery,
+                     AllocReplayResult *result);
+void printAllocReplayResult(const AllocReplayResult *result);
+int writeAllocSeries(const char *path, const AllocReplayResult *result); // CSV of the samples
+void freeAllocReplayResult(AllocReplayResult *result);
+int allocReplayDemo();
+
+#endif //CODE_ALLOC_REPLAY_H
@@ -0,0 +1,180 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the buddy allocator (buddy.c).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_BUDDY_ALLOCATOR_H
+#define CODE_BUDDY_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define BUDDY_MIN_ORDER 5 // 32-byte blocks, the smallest that can be handed out
+#define BUDDY_MAX_ORDER 40 // 1 TiB arena
+
+// Links of a free block, stored in the block itself
+typedef struct BuddyFreeBlock {
+    struct BuddyFreeBlock *next;
+    struct BuddyFreeBlock *prev;
+} BuddyFreeBlock;
+
+typedef struct {
+    unsigned char *arena;
+    size_t size; // Usable bytes; the tree covers the next power of two
+    int minOrder;
+    int maxOrder; // log2 of the size the tree covers
+    BuddyFreeBlock *freeLists[BUDDY_MAX_ORDER + 1]; // Indexed by order
+    size_t freeCounts[BUDDY_MAX_ORDER + 1];
+    uint64_t *freeBits; // One bit per tree node: the block is on a free list
+    uint64_t *splitBits; // One bit per tree node: the block is split into two buddies
+    size_t bitmapBytes; // Of each bitmap
+    size_t freeBytes;
+    unsigned char *reservation; // Address space reserved by buddyReserve, NULL for the caller's memory
+    size_t reservationSize;
+    uint64_t *committedBits; // One bit per 2 MiB chunk of a reserved arena: made readable and writable
+    size_t committedBytes; // Address space made accessible; pages become resident when first touched
+    int hugePageOrder; // Blocks of this order and up are committed with MADV_HUGEPAGE, 0 for never
+} BuddyAllocator;
+
+// Manage size bytes at memory, or reserve them with buddyReserve if memory is NULL.
+// Blocks are 2^minOrder bytes or larger. Returns 0 on success and -1 on error.
+int buddyInit(BuddyAllocator *allocator, void *memory, size_t size, int minOrder);
+// Reserve address space for an arena of up to 2^BUDDY_MAX_ORDER bytes and commit its pages only
+// as blocks are handed out. Takes the same time whatever the size.
+int buddyReserve(BuddyAllocator *allocator, size_t size, int minOrder, int hugePageOrder);
+void *buddyAlloc(BuddyAllocator *allocator, size_t size); // NULL if no block is large enough
+int buddyFree(BuddyAllocator *allocator, void *pointer); // -1 for a pointer that was not allocated
+// Bytes usable at pointer. Safe without the caller's lock while the block stays allocated.
+size_t buddyBlockSize(const BuddyAllocator *allocator, const void *pointer);
+void printBuddyFreeLists(const BuddyAllocator *allocator);
+void buddyDestroy(BuddyAllocator *allocator);
+int buddySys();
+int buddyLargeArenaDemo();
+
+// Per-thread magazine caches in front of a locked buddy allocator (magazine.c)
+#define MAGAZINE_ROUNDS 64 // Blocks per magazine
+#define MAGAZINE_ORDERS 8 // Cached orders, from minOrder up
+#define MAGAZINE_DEPOT_LIMIT 32 // Full magazines a depot keeps per order before returning blocks
+
+typedef struct Magazine {
+    struct Magazine *next; // Depot list
+    int rounds;
+    void *blocks[MAGAZINE_ROUNDS];
+} Magazine;
+
+// Full and empty magazines of one order, shared by all threads
+typedef struct {
+    pthread_mutex_t lock;
+    Magazine *full;
+    Magazine *empty;
+    int fullCount;
+    long long exchanges; // Magazines swapped with a thread cache
+} MagazineDepot;
+
+typedef struct {
+    BuddyAllocator buddy;
+    pthread_mutex_t buddyLock;
+    MagazineDepot depots[MAGAZINE_ORDERS];
+    pthread_key_t threadKey; // Thread -> its cache
+    long long buddyCalls; // Under buddyLock
+} MagazineAllocator;
+
+int magazineInit(MagazineAllocator *allocator, void *memory, size_t size, int minOrder);
+void *magazineAlloc(MagazineAllocator *allocator, size_t size);
+int magazineFree(MagazineAllocator *allocator, void *pointer);
+void magazineFlushThread(MagazineAllocator *allocator); // Give the calling thread's cached blocks back
+void magazineDestroy(MagazineAllocator *allocator); // After every other thread using it has exited
+int magazineDemo();
+
+// Object caches for fixed-size objects, built from buddy blocks (slab.c)
+#define SLAB_MIN_SIZE 4096 // Smallest slab taken from the buddy allocator
+#define SLAB_KEEP_EMPTY 1 // Empty slabs a cache keeps before giving them back
+
+typedef struct Slab {
+    struct Slab *next; // In the cache's partial, full or empty list
+    struct Slab *prev;
+    struct SlabCache *cache;
+    void *freeList; // Freed objects, linked through their first word
+    int inUse;
+    int unused; // Objects never handed out, taken from the end of the slab first
+} Slab;
+
+typedef struct SlabCache {
+    const char *name;
+    BuddyAllocator *buddy;
+    size_t objectSize; // Rounded up to the alignment
+    size_t slabSize; // A buddy block size
+    size_t firstObject; // Offset of the first object, after the slab header
+    int objectsPerSlab;
+    Slab *partial;
+    Slab *full;
+    Slab *empty;
+    int emptyCount;
+    long long slabs; // Slabs held now
+    long long objects; // Objects in use
+} SlabCache;
+
+int slabCacheInit(SlabCache *cache, BuddyAllocator *buddy, const char *name, size_t objectSize, size_t align);
+void *slabAlloc(SlabCache *cache); // NULL when the buddy allocator has no slab left
+int slabFree(SlabCache *cache, void *object); // -1 for an object of another cache
+void printSlabCacheStats(const SlabCache *cache);
+void slabCacheDestroy(SlabCache *cache); // Gives every slab back, including those with objects in use
+int slabDemo();
+
+// Buddy allocator without locks (lock-free-buddy.c)
+typedef struct {
+    uint64_t head; // Stack of nodes: tag in the high 32 bits, node + 1 in the low 32 bits
+    char pad[56]; // One cache line per order
+} LockFreeListHead;
+
+typedef struct {
+    unsigned char *arena;
+    size_t size;
+    int ownsArena;
+    int minOrder;
+    int maxOrder;
+    LockFreeListHead lists[BUDDY_MAX_ORDER + 1];
+    unsigned char *state; // Per tree node: on its order's stack, and free to claim
+    uint32_t *next; // Per tree node: the node below it on its stack
+    unsigned char *merging; // Per tree node: a thread is merging its two children
+    unsigned char *orders; // Per minimum-sized block: order of the allocated block that starts there
+} LockFreeBuddy;
+
+int lockFreeBuddyInit(LockFreeBuddy *allocator, void *memory, size_t size, int minOrder);
+void *lockFreeBuddyAlloc(LockFreeBuddy *allocator, size_t size);
+int lockFreeBuddyFree(LockFreeBuddy *allocator, void *pointer); // -1 for a pointer that is not allocated
+// Free bytes, free blocks and the largest free block, exact only while no other thread uses the allocator
+size_t lockFreeBuddyFreeBytes(const LockFreeBuddy *allocator, size_t *blocks, size_t *largest);
+void lockFreeBuddyDestroy(LockFreeBuddy *allocator);
+int lockFreeBuddyDemo();
+
+#endif //CODE_BUDDY_ALLOCATOR_H
@@ -0,0 +1,105 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the multi-process frame pool simulator (frame-pool.c).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_FRAME_POOL_SIM_H
+#define CODE_FRAME_POOL_SIM_H
+
+#include <stdio.h>
+#include "page-policy.h"
+
+#define POOL_GLOBAL_CLOCK 0 // One clock over every frame in the pool
+#define POOL_GLOBAL_LRU 1
+#define POOL_LOCAL_PFF 2 // Each process sizes its own resident set
+#define POOL_LOCAL_VSWS 3
+
+typedef struct {
+    int policy;
+    int poolFrames;
+    int quantum; // References a process runs before the next one gets the CPU
+    int faultCost; // Time of a fault in references, for throughput
+    int pffThreshold; // Local PFF: faults further apart than this release unused pages
+    int M, L, Q; // Local VSWS, as in VswsSim
+} FramePoolConfig;
+
+typedef struct {
+    const int *pages;
+    long long length;
+    long long position; // Next reference to run
+    long long faults;
+    long long residentSum; // Resident set size summed over the process's references
+    long long stolen; // Frames taken by other processes
+    PageIndex index; // Global policies: page -> frame
+    WorkingSet ws; // Local policies: the resident set
+    long long lastFault; // Local PFF, in the process's own references
+    long long lastSample; // Local VSWS
+    int intervalFaults;
+    int resident;
+} PoolProcess;
+
+typedef struct {
+    int owner; // Process, -1 if the frame is free
+    int page;
+    int useBit;
+    int prev; // Global LRU list, most recent at the head
+    int next;
+} PoolFrame;
+
+typedef struct {
+    FramePoolConfig config;
+    PoolProcess *processes;
+    int processCount;
+    PoolFrame *frames; // Global policies only
+    int *freeFrames;
+    int freeCount;
+    int hand;
+    int lruHead;
+    int lruTail;
+    int *runQueue; // Processes that still have references
+    int runCount;
+    int stealHand; // Next process to lose a frame when the pool runs dry under a local policy
+    int residentTotal;
+    long long references;
+    long long faults;
+    long long steals;
+} FramePoolSim;
+
+int framePoolSimInit(FramePoolSim *sim, const FramePoolConfig *config,
+                     const int *const traces[], const long long lengths[], int processCount);
+// Run every process to the end, round robin
+int framePoolRun(FramePoolSim *sim);
+// Per-process fault rates when there are few processes, then totals, fairness and throughput
+void printFramePoolStats(const FramePoolSim *sim, const char *label);
+void framePoolSimFree(FramePoolSim *sim);
+int framePoolDemo();
+
+#endif //CODE_FRAME_POOL_SIM_H
@@ -0,0 +1,541 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the page replacement simulators in src/08virtual_memory.
+    Besides the classic demos, every policy has a step-by-step version whose
+    frame count is chosen at run time. These versions take one page reference
+    at a time, so a long trace can be fed to several policies in one pass.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_PAGE_POLICY_H
+#define CODE_PAGE_POLICY_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Frame with a use bit, shared by the Clock simulators
+typedef struct {
+    int pageNumber;
+    int useBit;
+    int modifiedBit; // Written since it was loaded; only the enhanced Clock sets it
+} Frame;
+
+// Structure for representing a page in memory for LRU
+typedef struct {
+    int number; // Page number
+    int lastUsedTime; // The last time this page was accessed
+} PageFrame;
+
+// Hash table from page number to frame index (page-index.c)
+typedef struct {
+    int page; // -1 marks an empty slot
+    int frame;
+} PageSlot;
+
+typedef struct {
+    PageSlot *slots;
+    unsigned mask;
+    int shift;
+    int count; // Pages currently in the table
+} PageIndex;
+
+// capacity is the largest number of pages that will be resident at once
+int pageIndexInit(PageIndex *index, int capacity);
+int pageIndexFind(const PageIndex *index, int page); // Frame index, or -1 if absent
+void pageIndexInsert(PageIndex *index, int page, int frame);
+void pageIndexRemove(PageIndex *index, int page);
+// Grow the table so it can hold capacity pages. Returns 0 on success and -1 on error.
+int pageIndexReserve(PageIndex *index, int capacity);
+void pageIndexFree(PageIndex *index);
+
+// The classic demos, quiet or traced according to simOutputMode. Each returns its page faults.
+int fifo(int pages[], int frames[]);
+int LRUPageReplacement(int pages[]);
+int clockPageReplacement(int pages[], Frame frames[]);
+int simulatePFF(int pages[]);
+
+// Index of page in frames[0..count-1], or -1 (simd-lookup.c). Uses AVX2 or SSE2 when available.
+int findPageSimd(const int frames[], int count, int page);
+int findPageScalar(const int frames[], int count, int page);
+
+// Nodes and lists shared by the policies that keep several page lists (page-list.c)
+typedef struct {
+    int page;
+    int prev;
+    int next;
+    int list; // Which of the policy's lists the node is on
+    int flags; // Reference bit and other per-page state of the policy
+} ListNode;
+
+typedef struct {
+    int head;
+    int tail;
+    int size;
+} PageList;
+
+typedef struct {
+    ListNode *nodes;
+    int freeHead;
+    PageIndex index; // Page number -> node
+} NodePool;
+
+int nodePoolInit(NodePool *pool, int capacity);
+int nodePoolAlloc(NodePool *pool, int page); // Take a free node for page and index it
+void nodePoolRelease(NodePool *pool, int node); // Unindex the node and return it to the pool
+void nodePoolFree(NodePool *pool);
+void pageListInit(PageList *list);
+void pageListPushHead(NodePool *pool, PageList *list, int node);
+void pageListPushTail(NodePool *pool, PageList *list, int node);
+void pageListInsertBefore(NodePool *pool, PageList *list, int before, int node); // before == -1 appends
+void pageListRemove(NodePool *pool, PageList *list, int node);
+
+/*
+ * Step-by-step simulators. Each xxxSimInit() returns 0 on success and -1 if
+ * the frames could not be allocated. Each xxxSimAccess() processes one page
+ * reference and returns 1 on a page fault and 0 on a hit. xxxSimEvict(),
+ * where present, removes the page the policy would replace next and returns
+ * its number, or -1 if no page is resident.
+ */
+
+typedef struct {
+    int *frames;
+    int frameCount;
+    int insertIndex; // Oldest frame, replaced on the next fault
+} FifoSim;
+
+int fifoSimInit(FifoSim *sim, int frameCount);
+int fifoSimAccess(FifoSim *sim, int page);
+int fifoSimEvict(FifoSim *sim);
+int fifoSimContains(const FifoSim *sim, int page);
+void fifoSimFree(FifoSim *sim);
+
+typedef struct {
+    PageFrame *frames;
+    int frameCount;
+    int time;
+} LruSim;
+
+int lruSimInit(LruSim *sim, int frameCount);
+int lruSimAccess(LruSim *sim, int page);
+void lruSimFree(LruSim *sim);
+
+// LRU frame linked into the recency list by frame index
+typedef struct {
+    int pageNumber;
+    int prev; // Next more recently used frame, -1 at the head
+    int next; // Next less recently used frame, -1 at the tail
+} LruNode;
+
+// O(1) LRU: a hash index finds the frame, the recency list gives the victim
+typedef struct {
+    LruNode *nodes;
+    PageIndex index;
+    int frameCount;
+    int usedFrames;
+    int freeHead; // Frames emptied by lruHashSimEvict(), chained through next
+    int head; // Most recently used frame
+    int tail; // Least recently used frame
+} LruHashSim;
+
+int lruHashSimInit(LruHashSim *sim, int frameCount);
+int lruHashSimAccess(LruHashSim *sim, int page);
+int lruHashSimEvict(LruHashSim *sim);
+int lruHashSimContains(const LruHashSim *sim, int page);
+void lruHashSimFree(LruHashSim *sim);
+
+// Incremental LRU stack distances (stack-distance.c)
+typedef struct {
+    int *tree; // Fenwick tree over time slots, 1-based
+    int *pageAt; // Page whose latest access is in each slot, -1 if none
+    int capacity;
+    int now; // Next free time slot
+    PageIndex lastAccess; // Page number -> slot of its latest access
+} StackDistance;
+
+int stackDistanceInit(StackDistance *state);
+int stackDistanceAccess(StackDistance *state, int page); // Distance, 0 on a first reference, -1 on error
+void stackDistanceForget(StackDistance *state, int page); // Drop a page, as if never referenced
+void stackDistanceFree(StackDistance *state);
+
+// LRU faults for every frame count from one pass over a trace (stack-distance.c)
+typedef struct {
+    long long references;
+    long long coldMisses; // First references, which fault at any size
+    long long *distanceCounts; // distanceCounts[d]: references with stack distance d
+    int maxDistance;
+} MissRatioCurve;
+
+int computeMissRatioCurve(const int pages[], long long length, MissRatioCurve *curve);
+long long missRatioCurveFaults(const MissRatioCurve *curve, int frames);
+void writeMissRatioCurve(const MissRatioCurve *curve, FILE *out); // "frames faults miss_ratio" rows
+void freeMissRatioCurve(MissRatioCurve *curve);
+int stackDistanceTrace(const char *path, const char *outPath);
+
+// Belady's optimal policy (opt.c). computeNextUse() returns a malloc'ed array.
+int *computeNextUse(const int pages[], long long length);
+long long optSimulate(const int pages[], const int nextUse[], long long length, int frameCount);
+int compareWithOPT(const char *path, int frameCount);
+
+typedef struct {
+    Frame *frames;
+    int frameCount;
+    int pointer; // The clock hand
+} ClockSim;
+
+int clockSimInit(ClockSim *sim, int frameCount);
+int clockSimAccess(ClockSim *sim, int page);
+void clockSimFree(ClockSim *sim);
+
+// Clock with a vector page lookup and use bits packed 64 to a word (simd-lookup.c)
+typedef struct {
+    int *pages; // Page in each frame, -1 if empty
+    uint64_t *useBits;
+    int frameCount;
+    int words;
+    int pointer; // The clock hand
+} ClockBitSim;
+
+int clockBitSimInit(ClockBitSim *sim, int frameCount);
+int clockBitSimAccess(ClockBitSim *sim, int page);
+void clockBitSimFree(ClockBitSim *sim);
+
+// Clock with a page index, so hits never scan the frames
+typedef struct {
+    Frame *frames;
+    PageIndex index;
+    int *freeFrames; // Empty frames, used before the hand looks for a victim
+    int freeCount;
+    int frameCount;
+    int pointer; // The clock hand
+} ClockHashSim;
+
+int clockHashSimInit(ClockHashSim *sim, int frameCount);
+int clockHashSimAccess(ClockHashSim *sim, int page);
+int clockHashSimEvict(ClockHashSim *sim);
+int clockHashSimContains(const ClockHashSim *sim, int page);
+int clockHashSimPrefetch(ClockHashSim *sim, int page); // Load a page with its use bit clear
+void clockHashSimFree(ClockHashSim *sim);
+
+// Scan-resistant policies, built on the page lists above
+typedef struct {
+    NodePool pool;
+    PageList t1, t2; // Resident: seen once, seen more than once (MRU at head)
+    PageList b1, b2; // Ghosts recently evicted from t1 and t2
+    int c; // Frames
+    int p; // Target size of t1
+} ArcSim;
+
+int arcSimInit(ArcSim *sim, int frameCount);
+int arcSimAccess(ArcSim *sim, int page);
+int arcSimPrefetch(ArcSim *sim, int page); // Load a page as never seen; 0 if already resident
+int arcSimEvict(ArcSim *sim);
+int arcSimContains(const ArcSim *sim, int page);
+void arcSimFree(ArcSim *sim);
+
+typedef struct {
+    NodePool pool;
+    PageList t1, t2; // Resident clocks, the hand at the head
+    PageList b1, b2; // Ghost LRU lists (MRU at head)
+    int c;
+    int p;
+} CarSim;
+
+int carSimInit(CarSim *sim, int frameCount);
+int carSimAccess(CarSim *sim, int page);
+int carSimPrefetch(CarSim *sim, int page);
+int carSimEvict(CarSim *sim);
+int carSimContains(const CarSim *sim, int page);
+void carSimFree(CarSim *sim);
+
+typedef struct {
+    NodePool pool;
+    PageList a1in; // FIFO of pages seen once
+    PageList a1out; // FIFO ghost queue of pages evicted from a1in
+    PageList am; // LRU of pages seen again
+    int kin; // Size of a1in before it gives up frames
+    int kout; // Length of a1out
+    int frameCount;
+} TwoQueueSim;
+
+int twoQueueSimInit(TwoQueueSim *sim, int frameCount);
+int twoQueueSimAccess(TwoQueueSim *sim, int page);
+int twoQueueSimPrefetch(TwoQueueSim *sim, int page);
+int twoQueueSimEvict(TwoQueueSim *sim);
+int twoQueueSimContains(const TwoQueueSim *sim, int page);
+void twoQueueSimFree(TwoQueueSim *sim);
+
+typedef struct {
+    NodePool pool;
+    PageList clock; // Circular: the node after the tail is the head
+    int handHot, handCold, handTest;
+    int memMax; // Frames
+    int memCold; // Target number of cold resident pages
+    int countHot, countCold, countTest;
+    int lastEvicted;
+} ClockProSim;
+
+int clockProSimInit(ClockProSim *sim, int frameCount);
+int clockProSimAccess(ClockProSim *sim, int page);
+int clockProSimPrefetch(ClockProSim *sim, int page);
+int clockProSimEvict(ClockProSim *sim);
+int clockProSimContains(const ClockProSim *sim, int page);
+void clockProSimFree(ClockProSim *sim);
+
+typedef struct {
+    int *frames;
+    int maxFrames;
+    int frameCount; // Frames currently allocated to the process
+    int upperLimit; // Faults per interval above which a frame is added
+    int lowerLimit; // Faults per interval below which a frame is taken away
+    int interval; // References between two adjustments
+    int pointer;
+    int intervalFaults;
+    long long referenceCounter;
+} PffSim;
+
+int pffSimInit(PffSim *sim, int maxFrames, int upperLimit, int lowerLimit, int interval);
+int pffSimAccess(PffSim *sim, int page);
+void pffSimFree(PffSim *sim);
+
+// Denning's working set over the last delta references (working-set.c)
+typedef struct {
+    int page;
+    int prev;
+    int next;
+    long long lastReference;
+} WorkingSetNode;
+
+typedef struct {
+    WorkingSetNode *nodes; // Grows as needed
+    PageIndex index; // Page -> node
+    int capacity;
+    int used; // Nodes handed out so far
+    int freeHead; // Nodes of pages that left, chained through next
+    int head; // Most recently referenced
+    int tail; // Least recently referenced, the next to leave
+    int size; // |WS(t, delta)|
+    long long now; // References so far
+    long long delta; // Window length, 0 for no window
+} WorkingSet;
+
+int workingSetInit(WorkingSet *ws, int capacity, long long delta);
+int workingSetAccess(WorkingSet *ws, int page); // 1 if the page entered the set, 0 if it was in it, -1 on error
+int workingSetTrim(WorkingSet *ws, long long since); // Drop pages last referenced before since
+int workingSetEvictOldest(WorkingSet *ws);
+int workingSetContains(const WorkingSet *ws, int page);
+void workingSetFree(WorkingSet *ws);
+// Average working set size; writes "time wss" every so many references when out is not NULL
+double workingSetSeries(const int pages[], long long length, long long delta, long long every, FILE *out);
+
+// VSWS on the working set engine: the resident set is every page used since the last sample
+typedef struct {
+    WorkingSet ws;
+    int maxFrames;
+    int M; // Minimum duration of the sampling interval
+    int L; // Maximum duration of the sampling interval
+    int Q; // Allowed page faults between sampling instances
+    int intervalFaults;
+    long long samples;
+    long long lastSampleTime; // Time of the first reference in the current interval
+} VswsSim;
+
+int vswsSimInit(VswsSim *sim, int maxFrames, int M, int L, int Q);
+int vswsSimAccess(VswsSim *sim, int page);
+void vswsSimFree(VswsSim *sim);
+
+/*
+ * Common interface over the replacement policies (page-policy.c), so any of
+ * them can be run on the same trace. Policies are looked up by name:
+ * "fifo", "lru", "clock", "arc", "car", "2q" and "clock-pro".
+ */
+typedef struct {
+    const char *name;
+    size_t simSize;
+    int (*init)(void *sim, int frameCount);
+    int (*access)(void *sim, int page);
+    int (*evict)(void *sim);
+    void (*free)(void *sim);
+    int (*contains)(const void *sim, int page); // Resident, without counting as a reference
+    int (*prefetch)(void *sim, int page); // Load a page ahead of use; NULL means use access
+} PagePolicyOps;
+
+typedef struct {
+    long long references;
+    long long faults;
+    long long evictions; // Explicit evictions through pagePolicyEvict()
+} PolicyStats;
+
+typedef struct {
+    const PagePolicyOps *ops;
+    void *sim;
+    PolicyStats stats;
+} PagePolicy;
+
+extern const PagePolicyOps *const pagePolicies[];
+extern const int pagePolicyCount;
+
+const PagePolicyOps *findPagePolicy(const char *name);
+int pagePolicyInit(PagePolicy *policy, const PagePolicyOps *ops, int frameCount);
+int pagePolicyAccess(PagePolicy *policy, int page);
+int pagePolicyEvict(PagePolicy *policy);
+int pagePolicyContains(const PagePolicy *policy, int page);
+void pagePolicyFree(PagePolicy *policy);
+// Run every policy on the same trace and compare hit ratio and time per access
+int benchmarkPolicies(const char *path, int frameCount);
+
+// Sampled miss-ratio curves (shards.c). Pages are sampled by a hash of the page number,
+// so a sampled page keeps all its references and the stack distances scale by the rate.
+typedef struct {
+    double rate; // Starting sampling rate, in (0, 1]
+    int maxPages; // Most pages to track; the rate drops to stay under it. 0 keeps the rate fixed.
+    int bucketFrames; // Starting histogram resolution, in frames
+} ShardsConfig;
+
+#define SHARDS_GROUPS 16
+
+typedef struct {
+    long long references; // All references, sampled or not
+    long long sampled; // References that passed the hash filter
+    double coldMisses; // Scaled estimates from here on
+    double *buckets; // buckets[b]: references with a distance in ((b - 1) * bucketFrames, b * bucketFrames]
+    int bucketCount;
+    int bucketFrames;
+    double rate; // Sampling rate at the end of the trace
+    int trackedPages;
+    // The same histogram split by a hash of the page into SHARDS_GROUPS independent samples,
+    // groupBuckets[g * (bucketCount + 1) + b]; how much they disagree gives the sampling error
+    double *groupBuckets;
+    double groupColdMisses[SHARDS_GROUPS];
+} SampledMissRatioCurve;
+
+typedef struct {
+    ShardsConfig config;
+    StackDistance stack;
+    unsigned threshold; // Sample pages whose hash is below this
+    long long references;
+    long long sampled;
+    double coldMisses;
+    double *buckets;
+    int bucketCount;
+    int bucketFrames;
+    double *groupBuckets; // SHARDS_GROUPS histograms of MAX_BUCKETS + 1
+    double groupColdMisses[SHARDS_GROUPS];
+    struct ShardsHeapEntry *heap; // Max-heap of tracked pages by hash, only with maxPages
+    int heapSize;
+} ShardsSampler;
+
+int shardsInit(ShardsSampler *sampler, const ShardsConfig *config);
+int shardsAccess(ShardsSampler *sampler, int page);
+int shardsCurve(const ShardsSampler *sampler, SampledMissRatioCurve *curve);
+void shardsFree(ShardsSampler *sampler);
+double sampledCurveMissRatio(const SampledMissRatioCurve *curve, int frames);
+// About 95% bound on the error of the miss ratio at frames; wider where the curve is steep
+double sampledCurveErrorBound(const SampledMissRatioCurve *curve, int frames);
+void writeSampledCurve(const SampledMissRatioCurve *curve, FILE *out);
+void freeSampledCurve(SampledMissRatioCurve *curve);
+int shardsTrace(const char *path, const ShardsConfig *config, const char *outPath);
+// Any policy on the sampled references with frames scaled by the rate; returns the miss ratio or -1
+double miniatureMissRatio(const PagePolicyOps *ops, const int pages[], long long length, int frameCount, double rate);
+
+// Enhanced second-chance Clock over (use, modified) classes, with write-back costs (enhanced-clock.c)
+typedef struct {
+    int readCost; // Time to read a page in on a fault
+    int writeCost; // Time to write a dirty page back
+    int cleanInterval; // References between runs of the background cleaner, 0 for none
+    int cleanBatch; // Frames ahead of the hand the cleaner looks at per run
+    int plainClock; // 1: pick victims by use bit only, as clockPageReplacement() does
+} WritebackConfig;
+
+typedef struct {
+    Frame *frames;
+    PageIndex index;
+    int *freeFrames;
+    int freeCount;
+    int frameCount;
+    int pointer; // The clock hand
+    WritebackConfig config;
+    long long references;
+    long long writes; // Write references
+    long long faults;
+    long long writebacks; // Dirty victims written back while a fault waits
+    long long cleanerWrites; // Written back ahead of time by the cleaner
+    long long stallTime; // I/O time faults wait for: reads plus write-backs of dirty victims
+} EnhancedClockSim;
+
+int enhancedClockSimInit(EnhancedClockSim *sim, int frameCount, const WritebackConfig *config);
+int enhancedClockSimAccess(EnhancedClockSim *sim, int page, int isWrite);
+void printWritebackStats(const EnhancedClockSim *sim, const char *label);
+void enhancedClockSimFree(EnhancedClockSim *sim);
+// Text trace with one reference per line: "R 12" or "W 12" (a bare number is a read).
+// *pages and *writes are malloc'ed.
+int loadReadWriteTrace(const char *path, int **pages, unsigned char **writes, long long *length);
+int writebackTrace(const char *path, int frameCount, const WritebackConfig *config);
+
+// Readahead in front of any policy (prefetch.c)
+#define PREFETCH_MAX_STREAMS 32
+
+typedef struct {
+    int minWindow; // Pages read ahead when a stream is first detected
+    int maxWindow; // The window doubles on every refill up to this
+    int streams; // Streams tracked at once, up to PREFETCH_MAX_STREAMS
+    int maxStride; // Largest gap in pages taken as a stride; 1 detects sequential streams only
+} PrefetchConfig;
+
+typedef struct {
+    int lastPage;
+    int stride; // 0 until two references agree
+    int confirmed; // References that followed the stride
+    int window;
+    long long frontier; // Next page along the stream not yet read ahead
+    long long lastUse;
+} PrefetchStream;
+
+typedef struct {
+    PagePolicy policy;
+    PrefetchConfig config;
+    PrefetchStream streams[PREFETCH_MAX_STREAMS];
+    PageIndex pending; // Prefetched pages not referenced yet
+    long long time;
+    long long references;
+    long long faults; // Demand faults
+    long long issued; // Pages read ahead
+    long long useful; // Read ahead, then referenced while still resident
+    long long wasted; // Read ahead, then evicted before use
+} PrefetchSim;
+
+int prefetchSimInit(PrefetchSim *sim, const PagePolicyOps *ops, int frameCount, const PrefetchConfig *config);
+int prefetchSimAccess(PrefetchSim *sim, int page); // 1 on a demand fault
+// baselineFaults: faults of the same policy without readahead, or -1 if unknown
+void printPrefetchStats(const PrefetchSim *sim, long long baselineFaults);
+void prefetchSimFree(PrefetchSim *sim);
+int prefetchTrace(const char *path, const char *policyName, int frameCount, const PrefetchConfig *config);
+
+#endif //CODE_PAGE_POLICY_H
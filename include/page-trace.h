@@ -0,0 +1,137 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for page reference traces. A trace file is a flat array of
+    native int page numbers, the same layout as the int pages[] arrays used
+    by the demos, so it can be memory-mapped and read in place.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_PAGE_TRACE_H
+#define CODE_PAGE_TRACE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define PACKED_BLOCK_REFS 65536 // Default references per packed trace block
+
+typedef struct {
+    const int *pages; // Page references, read straight from the mapping
+    long long length; // Number of references
+    void *mapping;
+    size_t mappingSize;
+} PageTrace;
+
+// Map a trace file read-only. Returns 0 on success and -1 on error.
+int mapPageTrace(const char *path, PageTrace *trace);
+void unmapPageTrace(PageTrace *trace);
+
+// Write pages[0..length-1] as a trace file. Returns 0 on success and -1 on error.
+int writePageTrace(const char *path, const int pages[], long long length);
+
+// Writer for the packed trace format (trace-format.c)
+typedef struct {
+    FILE *file;
+    unsigned char *buffer; // Encoded bytes of the current block
+    size_t bufferUsed;
+    int blockRefs;
+    int blockUsed; // References in the current block
+    int previous; // Page the next delta is taken from
+    long long references;
+    unsigned long long offset; // File offset of the next block
+    unsigned long long *index; // File offset of every finished block
+    long long blockCount;
+    long long indexCapacity;
+} PackedTraceWriter;
+
+int packedTraceWriterOpen(PackedTraceWriter *writer, const char *path, int blockRefs);
+int packedTraceWriterAdd(PackedTraceWriter *writer, int page);
+int packedTraceWriterClose(PackedTraceWriter *writer);
+
+// A mapped packed trace. Blocks can be decoded in any order, from any thread.
+typedef struct {
+    const unsigned char *data;
+    int blockRefs;
+    long long references;
+    long long blockCount;
+    long long indexOffset;
+    void *mapping;
+    size_t mappingSize;
+} PackedTrace;
+
+int openPackedTrace(const char *path, PackedTrace *trace);
+void closePackedTrace(PackedTrace *trace);
+int packedTraceBlockLength(const PackedTrace *trace, long long block);
+// Decode one block into pages[], which must hold blockRefs ints.
+// Returns the number of references, or -1 if the block is corrupt.
+int decodePackedBlock(const PackedTrace *trace, long long block, int pages[]);
+// Convert a raw int trace, or a text file of page numbers, to a packed trace
+int convertTraceToPacked(const char *inPath, const char *outPath, int textInput);
+
+// Trace the pages of a page-aligned region touched by this process (page-tracer.c).
+// window is the number of recently touched pages left unprotected, at least 2 because one access can span two pages.
+int startPageTracer(void *region, size_t length, const char *outPath, int window);
+long long stopPageTracer();
+
+// Replay a trace file once through FIFO, LRU, Clock, PFF and VSWS
+int replayTrace(const char *path, int frameCount);
+// Same for a packed trace, decoded one block at a time
+int replayPackedTrace(const char *path, int frameCount);
+int traceReplayDemo();
+
+// Run PFF or VSWS once for every combination of the given parameter values,
+// spread over all cores (param-sweep.c)
+int sweepPFF(const char *path, int maxFrames, const int uppers[], int upperCount,
+             const int lowers[], int lowerCount, const int intervals[], int intervalCount);
+int sweepVSWS(const char *path, int maxFrames, const int Ms[], int MCount,
+              const int Ls[], int LCount, const int Qs[], int QCount);
+
+// How the classic demos (FIFODemo, LRUDemo, clockDemo, PFFDemo) report each reference (event-trace.c)
+#define SIM_OUTPUT_VERBOSE 0 // Print the frames after every reference
+#define SIM_OUTPUT_QUIET 1 // Only count faults
+#define SIM_OUTPUT_TRACE 2 // Send a PageEvent per reference to the event trace
+
+extern int simOutputMode;
+
+typedef struct {
+    int page;
+    int evicted; // Page replaced by this reference, -1 if none
+    int resident; // Resident set size after the reference
+    int hit;
+} PageEvent;
+
+// Start a background writer that drains a ring of capacity events (a power of two) into outPath,
+// and switch to SIM_OUTPUT_TRACE. Events must come from one thread at a time.
+int startEventTrace(const char *outPath, int capacity);
+void emitPageEvent(int page, int hit, int evicted, int resident);
+// Flush, stop the writer and restore the previous output mode. Returns the events written, or -1.
+long long stopEventTrace();
+int eventTraceDemo();
+
+#endif //CODE_PAGE_TRACE_H
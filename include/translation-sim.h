@@ -0,0 +1,165 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the address translation simulator (translation.c).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_TRANSLATION_SIM_H
+#define CODE_TRANSLATION_SIM_H
+
+#include "page-policy.h"
+
+#define INVERTED_PAGE_TABLE 0 // Use as the number of levels to get an inverted page table
+
+#define TLB_LRU 0
+#define TLB_FIFO 1
+#define TLB_RANDOM 2
+
+typedef struct {
+    int levels; // 2 to 4 levels, or INVERTED_PAGE_TABLE
+    int pageShift; // 12 for 4 KiB pages, 21 for 2 MiB pages
+    int addressBits; // Virtual address bits, 48 on x86-64
+    int tlbSets; // Power of two
+    int tlbWays;
+    int tlbPolicy; // TLB_LRU, TLB_FIFO or TLB_RANDOM
+    int frameCount; // Physical frames of the chosen page size
+} TranslationConfig;
+
+typedef struct {
+    unsigned long long vpn; // Virtual page number
+    int frame;
+    int valid;
+    long long stamp; // Last use (LRU) or insertion (FIFO)
+} TlbEntry;
+
+// Physical frame, the Frame of the Clock simulator with a 64-bit page number
+typedef struct {
+    unsigned long long vpn;
+    int inUse;
+    int useBit;
+} PhysicalFrame;
+
+typedef struct {
+    TranslationConfig config;
+    int levelShift[4]; // Shift of each level's index within the page number
+    int levelBits[4];
+    void **root; // Multi-level table: inner levels hold pointers, the last one frame + 1
+    int *hashAnchor; // Inverted table: first frame of each hash chain, -1 if none
+    int *hashNext; // Next frame in the same chain
+    TlbEntry *tlb;
+    PhysicalFrame *frames;
+    int usedFrames;
+    int pointer; // Clock hand over the physical frames
+    long long time;
+    long long references;
+    long long tlbHits;
+    long long walkReferences; // Memory references made by page walks
+    long long pageFaults;
+} TranslationSim;
+
+int translationSimInit(TranslationSim *sim, const TranslationConfig *config);
+// Translate one virtual address. Returns the physical address.
+unsigned long long translateAddress(TranslationSim *sim, unsigned long long address);
+void printTranslationStats(const TranslationSim *sim, const char *label);
+void translationSimFree(TranslationSim *sim);
+// Replay a file of native 64-bit virtual addresses
+int replayAddressTrace(const char *path, const TranslationConfig *config);
+int translationDemo();
+
+// Mixed 4 KiB / 2 MiB pages with transparent huge page policies (huge-page.c)
+#define THP_NEVER 0 // 4 KiB pages only
+#define THP_ALWAYS 1 // The first fault in an empty 2 MiB region maps the whole region
+#define THP_PROMOTE 2 // Start with 4 KiB pages; promote a region once enough of it is resident
+#define SUBPAGES 512 // 4 KiB pages per 2 MiB page
+
+typedef struct {
+    int thpMode;
+    int promoteThreshold; // THP_PROMOTE: resident 4 KiB pages a region needs, 1 to SUBPAGES
+    int demoteThreshold; // A huge victim with fewer touched 4 KiB pages than this is split, not evicted
+    long long memoryBytes; // Physical memory, a multiple of 4 KiB
+    int tlbEntries4K; // Entries of each TLB, a multiple of tlbWays
+    int tlbEntries2M;
+    int tlbWays;
+} HugePageConfig;
+
+typedef struct {
+    int number; // Virtual address >> 21
+    int huge; // Mapped by one 2 MiB page
+    int residentCount; // 4 KiB pages resident while not huge
+    unsigned long long resident[SUBPAGES / 64];
+    unsigned long long touched[SUBPAGES / 64]; // Touched since the region was last made huge
+    int hugeNode;
+    int *subNodes; // Clock node of each resident 4 KiB page, allocated on first use
+} HugeRegion;
+
+typedef struct {
+    int region; // Index into regions
+    int sub; // 4 KiB page within the region, -1 for the whole 2 MiB page
+    int useBit;
+    int prev;
+    int next;
+} HugeClockNode;
+
+typedef struct {
+    HugePageConfig config;
+    HugeRegion *regions;
+    int regionCount;
+    int regionCapacity;
+    PageIndex regionIndex; // Region number -> index into regions
+    HugeClockNode *nodes; // Resident pages of either size on one circular clock
+    int nodeCapacity;
+    int freeNode;
+    int hand;
+    TlbEntry *tlb4K;
+    TlbEntry *tlb2M;
+    long long totalFrames; // In 4 KiB frames
+    long long freeFrames;
+    long long peakFrames;
+    long long residentSum; // Resident frames summed over references
+    long long time;
+    long long references;
+    long long tlbHits;
+    long long walkReferences;
+    long long faults4K;
+    long long faults2M;
+    long long promotions;
+    long long demotions;
+    long long hugeEvictions;
+} HugePageSim;
+
+int hugePageSimInit(HugePageSim *sim, const HugePageConfig *config);
+int hugePageAccess(HugePageSim *sim, unsigned long long address); // 1 on a page fault, -1 on error
+void printHugePageStats(const HugePageSim *sim, const char *label);
+void hugePageSimFree(HugePageSim *sim);
+// Replay a file of native 64-bit virtual addresses
+int replayHugePageTrace(const char *path, const HugePageConfig *config);
+int hugePageDemo();
+
+#endif //CODE_TRANSLATION_SIM_H
@@ -0,0 +1,70 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Header file for the user-space demand pager (user-pager.c).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef CODE_USER_PAGER_H
+#define CODE_USER_PAGER_H
+
+#include <stddef.h>
+#include "page-policy.h"
+
+#define USER_PAGER_MAX 8 // Regions that can be paged at once
+
+// A region of the address space paged by Clock: at most frameCount of its pages are resident
+typedef struct {
+    char *base;
+    size_t length; // Rounded up to whole pages
+    size_t pageSize;
+    int pageCount;
+    int fd; // Backing file, an unlinked temporary file for an anonymous region
+    Frame *frames; // Resident pages; modifiedBit is set on the first write
+    int *frameOf; // Page -> frame, -1 if not resident
+    int frameCount;
+    int usedFrames;
+    int pointer; // Clock hand
+    long long pageFaults; // Pages brought in
+    long long referenceFaults; // Resident pages touched again after the hand cleared their use bit
+    long long writeFaults;
+    long long evictions;
+    long long writebacks;
+} UserPager;
+
+// Map length bytes of the file at path, creating or extending it as needed. With path NULL
+// the region is anonymous. Returns 0 on success and -1 on error.
+int userPagerOpen(UserPager *pager, const char *path, size_t length, int frameCount);
+// Write every modified resident page back. Returns 0 on success and -1 on error.
+int userPagerSync(UserPager *pager);
+int userPagerClose(UserPager *pager); // Syncs, then unmaps the region
+void printUserPagerStats(const UserPager *pager, const char *label);
+int userPagerDemo();
+
+#endif //CODE_USER_PAGER_H
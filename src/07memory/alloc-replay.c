@@ -0,0 +1,682 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Allocator trace replay harness. The allocators of this chapter (the buddy
+    allocator and the magazine, slab and lock-free layers over it) and the C
+    library's malloc sit behind one AllocatorOps table, so they can all replay
+    the same malloc/realloc/free trace. Traces can be read from a text file or
+    generated from a size distribution. Every trace is replayed twice per
+    engine:
+        - once straight through, for events per second,
+        - once timing each event on its own, for latency percentiles, and
+          sampling how much memory the live blocks asked for, how much the
+          allocator reserved for them (internal fragmentation), how much it
+          took in total (footprint), and how badly its free memory is split
+          up (external fragmentation: 1 - largest free block / free bytes).
+    An engine without its own realloc gets one built from alloc, copy and
+    free, which keeps the block when the new size still fits it and does not
+    waste more than half of it.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+#include "alloc-replay.h"
+#include "buddy-allocator.h"
+
+static size_t largestBuddyBlock(const BuddyAllocator *buddy) {
+    for (int order = buddy->maxOrder; order >= buddy->minOrder; order--) {
+        if (buddy->freeCounts[order] > 0) return (size_t)1 << order;
+    }
+    return 0;
+}
+
+static void buddyUsage(const BuddyAllocator *buddy, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    *footprint = buddy->size - buddy->freeBytes;
+    *freeBytes = buddy->freeBytes;
+    *largestFree = largestBuddyBlock(buddy);
+}
+
+// Buddy allocator
+static int buddyEngineInit(void *state, size_t arenaSize) {
+    return buddyInit((BuddyAllocator *)state, NULL, arenaSize, BUDDY_MIN_ORDER);
+}
+
+static void *buddyEngineAlloc(void *state, size_t size) {
+    return buddyAlloc((BuddyAllocator *)state, size);
+}
+
+static int buddyEngineFree(void *state, void *pointer) {
+    return buddyFree((BuddyAllocator *)state, pointer);
+}
+
+static size_t buddyEngineBlockSize(void *state, void *pointer) {
+    return buddyBlockSize((BuddyAllocator *)state, pointer);
+}
+
+static void buddyEngineUsage(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    buddyUsage((BuddyAllocator *)state, footprint, freeBytes, largestFree);
+}
+
+static void buddyEngineDestroy(void *state) {
+    buddyDestroy((BuddyAllocator *)state);
+}
+
+// Magazine caches; blocks held in magazines count as taken from the arena
+static int magazineEngineInit(void *state, size_t arenaSize) {
+    return magazineInit((MagazineAllocator *)state, NULL, arenaSize, BUDDY_MIN_ORDER);
+}
+
+static void *magazineEngineAlloc(void *state, size_t size) {
+    return magazineAlloc((MagazineAllocator *)state, size);
+}
+
+static int magazineEngineFree(void *state, void *pointer) {
+    return magazineFree((MagazineAllocator *)state, pointer);
+}
+
+static size_t magazineEngineBlockSize(void *state, void *pointer) {
+    return buddyBlockSize(&((MagazineAllocator *)state)->buddy, pointer);
+}
+
+static void magazineEngineUsage(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    buddyUsage(&((MagazineAllocator *)state)->buddy, footprint, freeBytes, largestFree);
+}
+
+static void magazineEngineDestroy(void *state) {
+    magazineDestroy((MagazineAllocator *)state);
+}
+
+// Slab caches for size classes up to 2 KiB, buddy blocks above that
+#define SLAB_CLASS_LIMIT 2048
+
+static const size_t slabClassSizes[] = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256,
+                                        320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048};
+#define SLAB_CLASSES (int)(sizeof(slabClassSizes) / sizeof(slabClassSizes[0]))
+
+typedef struct {
+    BuddyAllocator buddy;
+    SlabCache caches[SLAB_CLASSES];
+    unsigned char classOf[SLAB_CLASS_LIMIT / 16 + 1]; // (size + 15) / 16 -> cache
+} SlabEngine;
+
+static int slabEngineInit(void *state, size_t arenaSize) {
+    SlabEngine *engine = (SlabEngine *)state;
+    if (buddyInit(&engine->buddy, NULL, arenaSize, BUDDY_MIN_ORDER) < 0) return -1;
+
+    int c = 0;
+    for (int i = 0; i <= SLAB_CLASS_LIMIT / 16; i++) {
+        while (slabClassSizes[c] < (size_t)i * 16) c++;
+        engine->classOf[i] = (unsigned char)c;
+    }
+    for (c = 0; c < SLAB_CLASSES; c++) {
+        if (slabCacheInit(&engine->caches[c], &engine->buddy, "class", slabClassSizes[c], 16) < 0) {
+            buddyDestroy(&engine->buddy);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void *slabEngineAlloc(void *state, size_t size) {
+    SlabEngine *engine = (SlabEngine *)state;
+    if (size > SLAB_CLASS_LIMIT) return buddyAlloc(&engine->buddy, size);
+    return slabAlloc(&engine->caches[engine->classOf[(size + 15) / 16]]);
+}
+
+// A slab object lies inside a buddy block; a block handed out whole starts at its own address
+static Slab *slabOfObject(SlabEngine *engine, void *pointer, size_t *blockSize) {
+    size_t offset = (size_t)((unsigned char *)pointer - engine->buddy.arena);
+    *blockSize = buddyBlockSize(&engine->buddy, pointer);
+    size_t start = offset & ~(*blockSize - 1);
+    return start == offset ? NULL : (Slab *)(engine->buddy.arena + start);
+}
+
+static int slabEngineFree(void *state, void *pointer) {
+    SlabEngine *engine = (SlabEngine *)state;
+    size_t blockSize;
+    Slab *slab = slabOfObject(engine, pointer, &blockSize);
+    return slab == NULL ? buddyFree(&engine->buddy, pointer) : slabFree(slab->cache, pointer);
+}
+
+static size_t slabEngineBlockSize(void *state, void *pointer) {
+    size_t blockSize;
+    Slab *slab = slabOfObject((SlabEngine *)state, pointer, &blockSize);
+    return slab == NULL ? blockSize : slab->cache->objectSize;
+}
+
+static void slabEngineUsage(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    buddyUsage(&((SlabEngine *)state)->buddy, footprint, freeBytes, largestFree);
+}
+
+static void slabEngineDestroy(void *state) {
+    SlabEngine *engine = (SlabEngine *)state;
+    for (int c = 0; c < SLAB_CLASSES; c++) slabCacheDestroy(&engine->caches[c]);
+    buddyDestroy(&engine->buddy);
+}
+
+// Lock-free buddy allocator; its usage is a scan over the whole tree
+static int lockFreeEngineInit(void *state, size_t arenaSize) {
+    return lockFreeBuddyInit((LockFreeBuddy *)state, NULL, arenaSize, BUDDY_MIN_ORDER);
+}
+
+static void *lockFreeEngineAlloc(void *state, size_t size) {
+    return lockFreeBuddyAlloc((LockFreeBuddy *)state, size);
+}
+
+static int lockFreeEngineFree(void *state, void *pointer) {
+    return lockFreeBuddyFree((LockFreeBuddy *)state, pointer);
+}
+
+static size_t lockFreeEngineBlockSize(void *state, void *pointer) {
+    LockFreeBuddy *allocator = (LockFreeBuddy *)state;
+    size_t offset = (size_t)((unsigned char *)pointer - allocator->arena);
+    return (size_t)1 << allocator->orders[offset >> allocator->minOrder];
+}
+
+static void lockFreeEngineUsage(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    LockFreeBuddy *allocator = (LockFreeBuddy *)state;
+    size_t blocks;
+    *freeBytes = lockFreeBuddyFreeBytes(allocator, &blocks, largestFree);
+    *footprint = allocator->size - *freeBytes;
+}
+
+static void lockFreeEngineDestroy(void *state) {
+    lockFreeBuddyDestroy((LockFreeBuddy *)state);
+}
+
+// The C library's malloc. Its footprint is how much resident memory grew since init, after
+// free memory left over from earlier runs was given back to the system. The replay touches only
+// the ends of a block, so the untouched middle of a large block does not count.
+typedef struct {
+    size_t baseline;
+} MallocEngine;
+
+static size_t residentBytes() {
+    FILE *file = fopen("/proc/self/statm", "r");
+    unsigned long long size, resident = 0;
+
+    if (file == NULL) return 0; // Not Linux: no footprint
+    if (fscanf(file, "%llu %llu", &size, &resident) != 2) resident = 0;
+    fclose(file);
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static int mallocEngineInit(void *state, size_t arenaSize) {
+    (void)arenaSize;
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    ((MallocEngine *)state)->baseline = residentBytes();
+    return 0;
+}
+
+static void *mallocEngineAlloc(void *state, size_t size) {
+    (void)state;
+    return malloc(size);
+}
+
+static int mallocEngineFree(void *state, void *pointer) {
+    (void)state;
+    free(pointer);
+    return 0;
+}
+
+static void *mallocEngineRealloc(void *state, void *pointer, size_t size) {
+    (void)state;
+    return realloc(pointer, size);
+}
+
+static size_t mallocEngineBlockSize(void *state, void *pointer) {
+    (void)state;
+#if defined(__GLIBC__)
+    return malloc_usable_size(pointer);
+#elif defined(__APPLE__)
+    return malloc_size(pointer);
+#else
+    return 0; // Unknown: the harness counts the requested size
+#endif
+}
+
+static void mallocEngineUsage(void *state, size_t *footprint, size_t *freeBytes, size_t *largestFree) {
+    size_t bytes = residentBytes();
+    size_t baseline = ((MallocEngine *)state)->baseline;
+    *footprint = bytes > baseline ? bytes - baseline : 0;
+    *freeBytes = 0;
+    *largestFree = 0;
+}
+
+static void mallocEngineDestroy(void *state) {
+    (void)state;
+}
+
+#define ENGINE_OPS(label, type, prefix, reallocate) { label, sizeof(type), prefix##Init, prefix##Alloc, \
+    prefix##Free, reallocate, prefix##BlockSize, prefix##Usage, prefix##Destroy }
+
+static const AllocatorOps buddyEngine = ENGINE_OPS("buddy", BuddyAllocator, buddyEngine, NULL);
+static const AllocatorOps magazineEngine = ENGINE_OPS("magazine", MagazineAllocator, magazineEngine, NULL);
+static const AllocatorOps slabEngine = ENGINE_OPS("slab", SlabEngine, slabEngine, NULL);
+static const AllocatorOps lockFreeEngine = ENGINE_OPS("lock-free", LockFreeBuddy, lockFreeEngine, NULL);
+static const AllocatorOps mallocEngine = ENGINE_OPS("malloc", MallocEngine, mallocEngine, mallocEngineRealloc);
+
+const AllocatorOps *const allocatorEngines[] = {
+    &buddyEngine, &magazineEngine, &slabEngine, &lockFreeEngine, &mallocEngine
+};
+const int allocatorEngineCount = sizeof(allocatorEngines) / sizeof(allocatorEngines[0]);
+
+const AllocatorOps *findAllocatorEngine(const char *name) {
+    for (int i = 0; i < allocatorEngineCount; i++) {
+        if (strcmp(allocatorEngines[i]->name, name) == 0) return allocatorEngines[i];
+    }
+    return NULL;
+}
+
+static int appendEvent(AllocTrace *trace, long long *capacity, char op, int id, size_t size) {
+    if (trace->length == *capacity) {
+        long long bigger = *capacity > 0 ? *capacity * 2 : 4096;
+        AllocEvent *events = (AllocEvent *)realloc(trace->events, sizeof(AllocEvent) * bigger);
+        if (events == NULL) return -1;
+        trace->events = events;
+        *capacity = bigger;
+    }
+    trace->events[trace->length++] = (AllocEvent){op, id, size};
+    if (id > trace->maxId) trace->maxId = id;
+    return 0;
+}
+
+static size_t drawSize(const AllocTraceConfig *config) {
+    double u = rand() / ((double)RAND_MAX + 1.0);
+    size_t minSize = config->minSize, maxSize = config->maxSize;
+
+    switch (config->distribution) {
+    case SIZE_POWER_LAW:
+        return (size_t)(minSize * pow((double)maxSize / minSize, u));
+    case SIZE_BIMODAL:
+        if (rand() % 10 != 0) return minSize + (size_t)(u * 3 * minSize);
+        return maxSize / 4 + (size_t)(u * (maxSize - maxSize / 4));
+    default:
+        return minSize + (size_t)(u * (maxSize - minSize + 1));
+    }
+}
+
+int generateAllocTrace(const AllocTraceConfig *config, AllocTrace *trace) {
+    long long capacity = 0;
+    int *live = (int *)malloc(sizeof(int) * config->maxLive); // Live ids, in no order
+    int liveCount = 0;
+
+    memset(trace, 0, sizeof(*trace));
+    if (live == NULL || config->minSize == 0 || config->maxSize < config->minSize || config->maxLive < 1) {
+        printf("Invalid allocation trace configuration\n");
+        free(live);
+        return -1;
+    }
+    srand(config->seed);
+    int nextId = 0;
+    int *freeIds = (int *)malloc(sizeof(int) * config->maxLive);
+    int freeIdCount = 0;
+    if (freeIds == NULL) {
+        free(live);
+        return -1;
+    }
+
+    // Allocations outnumber frees until maxLive blocks are live, then the two balance
+    int status = 0;
+    while (trace->length < config->length && status == 0) {
+        if (liveCount == 0 || (liveCount < config->maxLive && rand() % 5 < 3)) {
+            int id = freeIdCount > 0 ? freeIds[--freeIdCount] : nextId++;
+            live[liveCount++] = id;
+            status = appendEvent(trace, &capacity, 'a', id, drawSize(config));
+        } else {
+            int i = rand() % liveCount;
+            if (rand() / ((double)RAND_MAX + 1.0) < config->reallocRate) {
+                status = appendEvent(trace, &capacity, 'r', live[i], drawSize(config));
+            } else {
+                freeIds[freeIdCount++] = live[i];
+                status = appendEvent(trace, &capacity, 'f', live[i], 0);
+                live[i] = live[--liveCount];
+            }
+        }
+    }
+    free(live);
+    free(freeIds);
+    if (status < 0) {
+        printf("Out of memory for the allocation trace\n");
+        freeAllocTrace(trace);
+    }
+    return status;
+}
+
+int loadAllocTrace(const char *path, AllocTrace *trace) {
+    FILE *file = fopen(path, "r");
+    long long capacity = 0;
+    char op;
+    int id;
+    size_t size;
+
+    memset(trace, 0, sizeof(*trace));
+    if (file == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    while (fscanf(file, " %c %d", &op, &id) == 2) {
+        size = 0;
+        if ((op != 'a' && op != 'r' && op != 'f') || id < 0 || (op != 'f' && fscanf(file, "%zu", &size) != 1)) {
+            printf("%s: bad event %lld\n", path, trace->length + 1);
+            fclose(file);
+            freeAllocTrace(trace);
+            return -1;
+        }
+        if (appendEvent(trace, &capacity, op, id, size) < 0) {
+            printf("Out of memory for the allocation trace\n");
+            fclose(file);
+            freeAllocTrace(trace);
+            return -1;
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+int writeAllocTrace(const char *path, const AllocTrace *trace) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    for (long long i = 0; i < trace->length; i++) {
+        const AllocEvent *event = &trace->events[i];
+        if (event->op == 'f') {
+            fprintf(file, "f %d\n", event->id);
+        } else {
+            fprintf(file, "%c %d %zu\n", event->op, event->id, event->size);
+        }
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+void freeAllocTrace(AllocTrace *trace) {
+    free(trace->events);
+    trace->events = NULL;
+    trace->length = 0;
+}
+
+typedef struct {
+    unsigned char *pointer;
+    size_t size;
+} LiveBlock;
+
+static double elapsedNanoseconds(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+static unsigned char *reallocBlock(const AllocatorOps *ops, void *state, LiveBlock *block, size_t size) {
+    if (ops->realloc != NULL) return (unsigned char *)ops->realloc(state, block->pointer, size);
+
+    size_t reserved = ops->blockSize(state, block->pointer);
+    if (size <= reserved && size > reserved / 2) return block->pointer;
+    unsigned char *pointer = (unsigned char *)ops->alloc(state, size);
+    if (pointer != NULL) {
+        memcpy(pointer, block->pointer, block->size < size ? block->size : size);
+        ops->free(state, block->pointer);
+    }
+    return pointer;
+}
+
+// Run one event. Returns 0, or 1 if an allocation failed.
+static int replayEvent(const AllocatorOps *ops, void *state, LiveBlock *block, const AllocEvent *event) {
+    unsigned char *pointer;
+
+    // A free, or a realloc to 0 bytes, which frees the block as realloc() does
+    if (event->op == 'f' || (event->op == 'r' && event->size == 0 && block->pointer != NULL)) {
+        if (block->pointer != NULL) ops->free(state, block->pointer);
+        block->pointer = NULL;
+        return 0;
+    }
+    if (event->op == 'r' && block->pointer != NULL) {
+        pointer = reallocBlock(ops, state, block, event->size);
+    } else {
+        if (block->pointer != NULL) ops->free(state, block->pointer); // Allocated twice in a row
+        block->pointer = NULL;
+        pointer = (unsigned char *)ops->alloc(state, event->size);
+    }
+    if (pointer == NULL) return 1; // A failed realloc leaves the old block in place
+    if (event->size > 0) pointer[0] = pointer[event->size - 1] = 1; // Use the block as a program would
+    block->pointer = pointer;
+    block->size = event->size;
+    return 0;
+}
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void takeSample(const AllocatorOps *ops, void *state, long long event, size_t requested, size_t reserved,
+                       AllocReplayResult *result) {
+    AllocSample *sample = &result->samples[result->sampleCount++];
+    size_t freeBytes, largestFree;
+
+    sample->event = event;
+    sample->requested = requested;
+    sample->reserved = reserved;
+    ops->usage(state, &sample->footprint, &freeBytes, &largestFree);
+    sample->internal = reserved > 0 ? 1.0 - (double)requested / reserved : 0.0;
+    sample->external = largestFree > 0 && freeBytes > 0 ? 1.0 - (double)largestFree / freeBytes : -1.0;
+    if (sample->footprint > result->peakFootprint) result->peakFootprint = sample->footprint;
+}
+
+int replayAllocTrace(const AllocatorOps *ops, const AllocTrace *trace, size_t arenaSize, int sampleEvery,
+                     AllocReplayResult *result) {
+    long long length = trace->length;
+    void *state = malloc(ops->stateSize);
+    LiveBlock *blocks = (LiveBlock *)calloc((size_t)trace->maxId + 1, sizeof(LiveBlock));
+    double *latencies = (double *)malloc(sizeof(double) * (length > 0 ? length : 1));
+    struct timespec start, end;
+
+    memset(result, 0, sizeof(*result));
+    result->engine = ops->name;
+    if (sampleEvery < 1) sampleEvery = 1;
+    result->samples = (AllocSample *)malloc(sizeof(AllocSample) * (length / sampleEvery + 2));
+    if (state == NULL || blocks == NULL || latencies == NULL || result->samples == NULL) {
+        printf("Out of memory for the allocation replay\n");
+        free(state);
+        free(blocks);
+        free(latencies);
+        free(result->samples);
+        result->samples = NULL;
+        return -1;
+    }
+
+    // What reading the clock costs, taken off every timed event
+    double overhead = 1e9;
+    for (int i = 0; i < 1000; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ns = elapsedNanoseconds(&start, &end);
+        if (ns < overhead) overhead = ns;
+    }
+
+    int status = 0;
+    for (int run = 0; run < 2 && status == 0; run++) {
+        size_t requested = 0, reserved = 0;
+        if (ops->init(state, arenaSize) < 0) {
+            status = -1;
+            break;
+        }
+
+        if (run == 0) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long long i = 0; i < length; i++) {
+                replayEvent(ops, state, &blocks[trace->events[i].id], &trace->events[i]);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            result->opsPerSecond = length / (elapsedNanoseconds(&start, &end) / 1e9);
+        } else {
+            for (long long i = 0; i < length; i++) {
+                LiveBlock *block = &blocks[trace->events[i].id];
+                // Bookkeeping is left out of the timed part
+                if (block->pointer != NULL) {
+                    size_t blockSize = ops->blockSize(state, block->pointer);
+                    requested -= block->size;
+                    reserved -= blockSize > 0 ? blockSize : block->size; // Same fallback as when it was added
+                }
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                result->failures += replayEvent(ops, state, block, &trace->events[i]);
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                double ns = elapsedNanoseconds(&start, &end) - overhead;
+                latencies[i] = ns > 0 ? ns : 0;
+
+                if (block->pointer != NULL) {
+                    size_t blockSize = ops->blockSize(state, block->pointer);
+                    requested += block->size;
+                    reserved += blockSize > 0 ? blockSize : block->size;
+                }
+                if (reserved > result->peakReserved) result->peakReserved = reserved;
+                if (i % sampleEvery == 0) takeSample(ops, state, i, requested, reserved, result);
+            }
+            takeSample(ops, state, length, requested, reserved, result);
+        }
+
+        for (long long id = 0; id <= trace->maxId; id++) {
+            if (blocks[id].pointer != NULL) ops->free(state, blocks[id].pointer);
+            blocks[id].pointer = NULL;
+        }
+        ops->destroy(state);
+    }
+
+    if (status == 0 && length > 0) {
+        qsort(latencies, length, sizeof(double), compareDoubles);
+        result->p50 = latencies[length / 2];
+        result->p99 = latencies[(long long)(length * 0.99)];
+        result->p999 = latencies[(long long)(length * 0.999)];
+        result->maxLatency = latencies[length - 1];
+    }
+    free(state);
+    free(blocks);
+    free(latencies);
+    return status;
+}
+
+void printAllocReplayResult(const AllocReplayResult *result) {
+    double internal = 0.0, external = result->sampleCount > 0 ? result->samples[result->sampleCount - 1].external : -1.0;
+    for (int i = 0; i < result->sampleCount; i++) internal += result->samples[i].internal / result->sampleCount;
+
+    printf("%-10s %7.2f %6.0f %6.0f %7.0f %8.0f %9.1f %9.1f %8.3f ", result->engine, result->opsPerSecond / 1e6,
+           result->p50, result->p99, result->p999, result->maxLatency, result->peakReserved / 1048576.0,
+           result->peakFootprint / 1048576.0, internal);
+    if (external >= 0) {
+        printf("%8.3f", external);
+    } else {
+        printf("%8s", "n/a");
+    }
+    printf(" %7lld\n", result->failures);
+}
+
+int writeAllocSeries(const char *path, const AllocReplayResult *result) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    fprintf(file, "event,requested,reserved,footprint,internal,external\n");
+    for (int i = 0; i < result->sampleCount; i++) {
+        const AllocSample *s = &result->samples[i];
+        fprintf(file, "%lld,%zu,%zu,%zu,%.4f,%.4f\n", s->event, s->requested, s->reserved, s->footprint,
+                s->internal, s->external);
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+void freeAllocReplayResult(AllocReplayResult *result) {
+    free(result->samples);
+    result->samples = NULL;
+    result->sampleCount = 0;
+}
+
+int allocReplayDemo() {
+    const char *path = "alloc-trace-demo.txt";
+    const char *workloads[] = {"small objects, power law 16 B - 4 KiB", "bimodal 16 B / 8 - 32 KiB",
+                               "realloc-heavy, uniform 64 B - 16 KiB"};
+    AllocTraceConfig configs[] = {
+        {SIZE_POWER_LAW, 16, 4096, 20000, 0.0, 1000000, 1},
+        {SIZE_BIMODAL, 16, 32768, 10000, 0.0, 1000000, 2},
+        {SIZE_UNIFORM, 64, 16384, 5000, 0.5, 1000000, 3},
+    };
+
+    for (int w = 0; w < 3; w++) {
+        AllocTrace trace;
+
+        // Round trip through a file, as a recorded trace would come in
+        if (generateAllocTrace(&configs[w], &trace) < 0) return -1;
+        int status = writeAllocTrace(path, &trace);
+        freeAllocTrace(&trace);
+        if (status < 0 || loadAllocTrace(path, &trace) < 0) {
+            unlink(path);
+            return -1;
+        }
+        unlink(path);
+
+        printf("%s, %lld events\n", workloads[w], trace.length);
+        printf("%-10s %7s %6s %6s %7s %8s %9s %9s %8s %8s %7s\n", "engine", "Mops/s", "p50", "p99", "p99.9",
+               "max ns", "peak MiB", "foot MiB", "int avg", "ext end", "failed");
+        AllocReplayResult results[5];
+        for (int e = 0; e < allocatorEngineCount; e++) {
+            if (replayAllocTrace(allocatorEngines[e], &trace, 128 << 20, 10000, &results[e]) < 0) {
+                freeAllocTrace(&trace);
+                return -1;
+            }
+            printAllocReplayResult(&results[e]);
+        }
+
+        // External fragmentation of the buddy-based engines over the run
+        printf("%-10s", "external");
+        for (int s = 0; s <= 4; s++) printf(" %9s", s == 0 ? "start" : s == 4 ? "end" : "");
+        printf("\n");
+        for (int e = 0; e < allocatorEngineCount; e++) {
+            if (results[e].samples[results[e].sampleCount - 1].external < 0) continue;
+            printf("%-10s", results[e].engine);
+            for (int s = 0; s <= 4; s++) {
+                printf(" %9.3f", results[e].samples[(results[e].sampleCount - 1) * s / 4].external);
+            }
+            printf("\n");
+        }
+        for (int e = 0; e < allocatorEngineCount; e++) freeAllocReplayResult(&results[e]);
+        freeAllocTrace(&trace);
+        printf("\n");
+    }
+    return 0;
+}
@@ -2,13 +2,22 @@
     Name: Dr. Qixin Deng
     Date: February 28, 2024
     Description:
-    The code is a C program that implements mutual exclusion solutions, specifically
-    Dekker's and Peterson's algorithms, to control access to a critical section in a
-    concurrent programming environment. It uses shared variables to indicate the desire
-    of threads to enter the critical section and a turn variable to decide whose turn
-    it is to enter. The program creates two threads, each representing a process, and
-    alternates between them to demonstrate mutual exclusion and ensure that only one
-    thread can execute in the critical section at a time.
+    Buddy allocator over one contiguous arena. Block sizes are powers of two
+    from 2^minOrder bytes up to the whole arena, and every block of order k
+    starts at an offset that is a multiple of 2^k, so a block's buddy is found
+    by flipping bit k of its offset. The allocator keeps
+        - one doubly linked free list per order, threaded through the free
+          blocks themselves, so no metadata is allocated per block,
+        - a free bitmap and a split bitmap with one bit per node of the
+          implicit block tree, so a free can find the block's order and test
+          its buddy without a header in front of the block.
+    Allocation and free take O(log N) steps for an arena of N minimum-sized
+    blocks. An arena whose size is not a power of two is covered by the next
+    power of two, and the part past the end is never put on a free list.
+    Without caller memory the arena is only reserved, with mmap(PROT_NONE),
+    and committed in BUDDY_COMMIT_CHUNK pieces as blocks are handed out. The
+    bitmaps are mapped too, so the kernel zeroes their pages on first use.
+    Setting up an arena of tens of GiB therefore costs no more than 4 MiB.
 
     Contact Information:
     - Email: dengq@wabash.edu
@@ -38,104 +47,397 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
-
-#define MAX_MEM_SIZE 1024 // Maximum memory size
-#define MIN_BLOCK_SIZE 32 // Minimum block size
-
-typedef struct Block {
-    int size;
-    int isFree;
-    struct Block *next;
-    struct Block *prev;
-    struct Block *buddy;
-} Block;
-
-Block *head = NULL;
-
-// Initialize memory with a single large block
-void initializeMemory() {
-    head = (Block *)malloc(sizeof(Block));
-    head->size = MAX_MEM_SIZE;
-    head->isFree = 1;
-    head->next = head->prev = head->buddy = NULL;
-}
-
-// Allocate memory using the Buddy System
-void *buddySplit(int size) {
-    Block *current = head;
-    int adjustedSize = (int)pow(2, ceil(log(size) / log(2))); // Adjust size to next power of 2
-
-    if (adjustedSize < MIN_BLOCK_SIZE) adjustedSize = MIN_BLOCK_SIZE;
-
-    while (current) {
-        if (current->isFree && current->size >= adjustedSize) {
-            while (current->size / 2 >= size) {
-                Block *buddy = (Block *)malloc(sizeof(Block));
-                buddy->size = current->size / 2;
-                current->size /= 2;
-
-                buddy->next = current->next;
-                buddy->prev = current;
-                buddy->buddy = current;
-                buddy->isFree = 1;
-
-                if (current->next) current->next->prev = buddy;
-                current->next = buddy;
-                current->buddy = buddy;
-            }
-            current->isFree = 0;
-            return current;
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "buddy-allocator.h"
+
+#define MAX_MEM_SIZE (4 << 20) // Arena of the demo
+#define BUDDY_COMMIT_CHUNK ((size_t)2 << 20) // Commit granularity and alignment of a reserved arena
+
+static int floorLog2(size_t n) {
+    return 63 - __builtin_clzll((unsigned long long)n);
+}
+
+static int ceilLog2(size_t n) {
+    return n <= 1 ? 0 : 64 - __builtin_clzll((unsigned long long)(n - 1));
+}
+
+// Tree nodes are numbered level by level from the root, which has order maxOrder
+static size_t nodeIndex(const BuddyAllocator *allocator, size_t offset, int order) {
+    return ((size_t)1 << (allocator->maxOrder - order)) - 1 + (offset >> order);
+}
+
+// Bitmap words are loaded and stored atomically, so buddyBlockSize() can read them while
+// another thread changes the allocator under a lock. Writers still need that lock.
+static int testBit(const uint64_t *bits, size_t i) {
+    return (int)(__atomic_load_n(&bits[i >> 6], __ATOMIC_RELAXED) >> (i & 63) & 1);
+}
+
+static void setBit(uint64_t *bits, size_t i) {
+    __atomic_store_n(&bits[i >> 6], __atomic_load_n(&bits[i >> 6], __ATOMIC_RELAXED) | 1ull << (i & 63), __ATOMIC_RELAXED);
+}
+
+static void clearBit(uint64_t *bits, size_t i) {
+    __atomic_store_n(&bits[i >> 6], __atomic_load_n(&bits[i >> 6], __ATOMIC_RELAXED) & ~(1ull << (i & 63)), __ATOMIC_RELAXED);
+}
+
+static void pushFreeBlock(BuddyAllocator *allocator, size_t offset, int order) {
+    BuddyFreeBlock *block = (BuddyFreeBlock *)(allocator->arena + offset);
+
+    block->prev = NULL;
+    block->next = allocator->freeLists[order];
+    if (block->next != NULL) block->next->prev = block;
+    allocator->freeLists[order] = block;
+    allocator->freeCounts[order]++;
+    allocator->freeBytes += (size_t)1 << order;
+    setBit(allocator->freeBits, nodeIndex(allocator, offset, order));
+}
+
+static void removeFreeBlock(BuddyAllocator *allocator, size_t offset, int order) {
+    BuddyFreeBlock *block = (BuddyFreeBlock *)(allocator->arena + offset);
+
+    if (block->prev != NULL) {
+        block->prev->next = block->next;
+    } else {
+        allocator->freeLists[order] = block->next;
+    }
+    if (block->next != NULL) block->next->prev = block->prev;
+    allocator->freeCounts[order]--;
+    allocator->freeBytes -= (size_t)1 << order;
+    clearBit(allocator->freeBits, nodeIndex(allocator, offset, order));
+}
+
+// The block holding offset is the first node on the way up from the leaves whose parent is
+// split. Starting at the leaves keeps the walk short for the small blocks that are most common.
+static int blockOrder(const BuddyAllocator *allocator, size_t offset) {
+    int order = allocator->minOrder;
+    while (order < allocator->maxOrder &&
+           !testBit(allocator->splitBits, nodeIndex(allocator, offset & ~(((size_t)2 << order) - 1), order + 1))) {
+        order++;
+    }
+    return order;
+}
+
+// Anonymous zero-filled memory whose pages are only backed once touched
+static void *mapZeroed(size_t bytes) {
+    void *memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+// Make [offset, offset + length) of a reserved arena accessible, one chunk at a time
+static int commitRange(BuddyAllocator *allocator, size_t offset, size_t length) {
+    if (allocator->committedBits == NULL) return 0;
+
+    size_t chunk = offset / BUDDY_COMMIT_CHUNK;
+    size_t last = (offset + length - 1) / BUDDY_COMMIT_CHUNK;
+    while (chunk <= last) {
+        if (testBit(allocator->committedBits, chunk)) {
+            chunk++;
+            continue;
         }
-        current = current->next;
+        // One mprotect for each run of uncommitted chunks
+        size_t end = chunk;
+        while (end <= last && !testBit(allocator->committedBits, end)) setBit(allocator->committedBits, end++);
+        if (mprotect(allocator->arena + chunk * BUDDY_COMMIT_CHUNK, (end - chunk) * BUDDY_COMMIT_CHUNK,
+                     PROT_READ | PROT_WRITE) < 0) {
+            while (chunk < end) clearBit(allocator->committedBits, chunk++);
+            return -1;
+        }
+        allocator->committedBytes += (end - chunk) * BUDDY_COMMIT_CHUNK;
+        chunk = end;
     }
-    return NULL; // No suitable block found
+    return 0;
 }
 
-// Merge buddies if possible
-void buddyMerge(void *ptr) {
-    Block *block = (Block *)ptr; // Get block metadata from memory address
-    if (block->buddy && block->buddy->isFree && block->size == block->buddy->size) {
-        block->isFree = 1;
-        block->next = block->buddy->next;
-        if (block->buddy->next) block->buddy->next->prev = block->buddy->prev;
+static int setupTree(BuddyAllocator *allocator, size_t size, int minOrder) {
+    memset(allocator, 0, sizeof(*allocator));
+    if (minOrder < 0 || ((size_t)1 << minOrder) < sizeof(BuddyFreeBlock) || minOrder > BUDDY_MAX_ORDER) {
+        printf("Invalid minimum block order %d\n", minOrder);
+        return -1;
+    }
+    size &= ~(((size_t)1 << minOrder) - 1);
+    if (size == 0 || ceilLog2(size) > BUDDY_MAX_ORDER) {
+        printf("Invalid arena size %zu\n", size);
+        return -1;
+    }
+    allocator->size = size;
+    allocator->minOrder = minOrder;
+    allocator->maxOrder = ceilLog2(size);
 
-        block->size *= 2;
-        free(block->buddy);
-        block->buddy = block->prev;
-        block->isFree = 1;
+    size_t nodes = ((size_t)1 << (allocator->maxOrder - minOrder + 1)) - 1;
+    allocator->bitmapBytes = (nodes + 63) / 64 * sizeof(uint64_t);
+    allocator->freeBits = (uint64_t *)mapZeroed(allocator->bitmapBytes);
+    allocator->splitBits = (uint64_t *)mapZeroed(allocator->bitmapBytes);
+    if (allocator->freeBits == NULL || allocator->splitBits == NULL) {
+        printf("Out of memory for the buddy allocator\n");
+        buddyDestroy(allocator);
+        return -1;
+    }
+    return 0;
+}
 
-        buddyMerge(block); // Recursively try to merge with its buddy
+// Cover the arena with the largest aligned blocks that fit, splitting their ancestors
+static int seedFreeLists(BuddyAllocator *allocator) {
+    size_t offset = 0;
+    while (offset < allocator->size) {
+        int order = floorLog2(allocator->size - offset);
+        if (offset != 0 && __builtin_ctzll((unsigned long long)offset) < order) {
+            order = __builtin_ctzll((unsigned long long)offset);
+        }
+        if (commitRange(allocator, offset, sizeof(BuddyFreeBlock)) < 0) return -1;
+        for (int o = allocator->maxOrder; o > order; o--) {
+            setBit(allocator->splitBits, nodeIndex(allocator, offset & ~(((size_t)1 << o) - 1), o));
+        }
+        pushFreeBlock(allocator, offset, order);
+        offset += (size_t)1 << order;
     }
+    return 0;
 }
 
-void printMemoryTree() {
-    Block *current = head;
-    printf("Memory Blocks:\n");
-    while (current != NULL) {
-        printf("Block Size: %d, Status: %s\n", current->size, current->isFree ? "Free" : "Allocated");
-        current = current->next;
+int buddyInit(BuddyAllocator *allocator, void *memory, size_t size, int minOrder) {
+    if (memory == NULL) return buddyReserve(allocator, size, minOrder, 0);
+    if (setupTree(allocator, size, minOrder) < 0) return -1;
+    allocator->arena = (unsigned char *)memory;
+    return seedFreeLists(allocator);
+}
+
+int buddyReserve(BuddyAllocator *allocator, size_t size, int minOrder, int hugePageOrder) {
+    if (setupTree(allocator, size, minOrder) < 0) return -1;
+    allocator->hugePageOrder = hugePageOrder;
+
+    // Reserve one chunk extra so the arena can start on a chunk boundary
+    size_t chunks = (allocator->size + BUDDY_COMMIT_CHUNK - 1) / BUDDY_COMMIT_CHUNK;
+    allocator->reservationSize = (chunks + 1) * BUDDY_COMMIT_CHUNK;
+    void *reservation = mmap(NULL, allocator->reservationSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    allocator->committedBits = (uint64_t *)mapZeroed((chunks + 63) / 64 * sizeof(uint64_t));
+    if (reservation == MAP_FAILED || allocator->committedBits == NULL) {
+        perror("mmap");
+        if (reservation != MAP_FAILED) munmap(reservation, allocator->reservationSize);
+        buddyDestroy(allocator);
+        return -1;
+    }
+    allocator->reservation = (unsigned char *)reservation;
+    allocator->arena = (unsigned char *)(((uintptr_t)reservation + BUDDY_COMMIT_CHUNK - 1) & ~(uintptr_t)(BUDDY_COMMIT_CHUNK - 1));
+    if (seedFreeLists(allocator) < 0) {
+        perror("mprotect");
+        buddyDestroy(allocator);
+        return -1;
     }
+    return 0;
+}
+
+void *buddyAlloc(BuddyAllocator *allocator, size_t size) {
+    if (size > (size_t)1 << allocator->maxOrder) return NULL;
+    int order = ceilLog2(size);
+    if (order < allocator->minOrder) order = allocator->minOrder;
+
+    int k = order;
+    while (k <= allocator->maxOrder && allocator->freeLists[k] == NULL) k++;
+    if (k > allocator->maxOrder) return NULL;
+
+    // Commit the block and the links of the halves split off it before changing anything
+    size_t offset = (size_t)((unsigned char *)allocator->freeLists[k] - allocator->arena);
+    for (int j = k - 1; j >= order; j--) {
+        if (commitRange(allocator, offset + ((size_t)1 << j), sizeof(BuddyFreeBlock)) < 0) return NULL;
+    }
+    if (commitRange(allocator, offset, (size_t)1 << order) < 0) return NULL;
+#ifdef MADV_HUGEPAGE
+    if (allocator->hugePageOrder > 0 && order >= allocator->hugePageOrder) {
+        madvise(allocator->arena + offset, (size_t)1 << order, MADV_HUGEPAGE);
+    }
+#endif
+    removeFreeBlock(allocator, offset, k);
+    // Split down to the requested order, keeping the lower half and freeing the upper one
+    while (k > order) {
+        setBit(allocator->splitBits, nodeIndex(allocator, offset, k));
+        k--;
+        pushFreeBlock(allocator, offset + ((size_t)1 << k), k);
+    }
+    return allocator->arena + offset;
+}
+
+int buddyFree(BuddyAllocator *allocator, void *pointer) {
+    if (pointer == NULL) return 0;
+
+    size_t offset = (size_t)((unsigned char *)pointer - allocator->arena);
+    if ((unsigned char *)pointer < allocator->arena || offset >= allocator->size ||
+        (offset & (((size_t)1 << allocator->minOrder) - 1)) != 0) {
+        printf("buddyFree: %p is not in the arena\n", pointer);
+        return -1;
+    }
+    int order = blockOrder(allocator, offset);
+    if ((offset & (((size_t)1 << order) - 1)) != 0 || testBit(allocator->freeBits, nodeIndex(allocator, offset, order))) {
+        printf("buddyFree: %p is not an allocated block\n", pointer);
+        return -1;
+    }
+
+    // Merge with the buddy for as long as the buddy is free
+    while (order < allocator->maxOrder) {
+        size_t buddy = offset ^ ((size_t)1 << order);
+        if (!testBit(allocator->freeBits, nodeIndex(allocator, buddy, order))) break;
+        removeFreeBlock(allocator, buddy, order);
+        offset &= ~((size_t)1 << order);
+        order++;
+        clearBit(allocator->splitBits, nodeIndex(allocator, offset, order));
+    }
+    pushFreeBlock(allocator, offset, order);
+    return 0;
+}
+
+size_t buddyBlockSize(const BuddyAllocator *allocator, const void *pointer) {
+    size_t offset = (size_t)((const unsigned char *)pointer - allocator->arena);
+    return (size_t)1 << blockOrder(allocator, offset);
+}
+
+void printBuddyFreeLists(const BuddyAllocator *allocator) {
+    printf("Free blocks, %zu of %zu bytes free:\n", allocator->freeBytes, allocator->size);
+    for (int order = allocator->minOrder; order <= allocator->maxOrder; order++) {
+        if (allocator->freeCounts[order] > 0) {
+            printf("  %10zu bytes: %zu\n", (size_t)1 << order, allocator->freeCounts[order]);
+        }
+    }
+}
+
+void buddyDestroy(BuddyAllocator *allocator) {
+    if (allocator->reservation != NULL) munmap(allocator->reservation, allocator->reservationSize);
+    if (allocator->committedBits != NULL) {
+        size_t chunks = (allocator->size + BUDDY_COMMIT_CHUNK - 1) / BUDDY_COMMIT_CHUNK;
+        munmap(allocator->committedBits, (chunks + 63) / 64 * sizeof(uint64_t));
+    }
+    if (allocator->freeBits != NULL) munmap(allocator->freeBits, allocator->bitmapBytes);
+    if (allocator->splitBits != NULL) munmap(allocator->splitBits, allocator->bitmapBytes);
+    allocator->arena = allocator->reservation = NULL;
+    allocator->freeBits = allocator->splitBits = allocator->committedBits = NULL;
 }
 
 int buddySys() {
-    initializeMemory();
+    const int slots = 4096;
+    const int operations = 2000000;
+    BuddyAllocator allocator;
+    struct timespec start, end;
+
+    if (buddyInit(&allocator, NULL, MAX_MEM_SIZE, BUDDY_MIN_ORDER) < 0) return -1;
 
     // Example usage
-    void *ptr1 = buddySplit(100);
-    void *ptr2 = buddySplit(200);
+    void *ptr1 = buddyAlloc(&allocator, 100);
+    void *ptr2 = buddyAlloc(&allocator, 200);
+    printf("100 bytes at offset %td (%zu-byte block), 200 bytes at offset %td (%zu-byte block)\n",
+           (unsigned char *)ptr1 - allocator.arena, buddyBlockSize(&allocator, ptr1),
+           (unsigned char *)ptr2 - allocator.arena, buddyBlockSize(&allocator, ptr2));
+    printBuddyFreeLists(&allocator);
+    buddyFree(&allocator, ptr1);
+    buddyFree(&allocator, ptr2);
+    printBuddyFreeLists(&allocator);
+
+    // Random allocations and frees; each block is filled with its slot number and checked on free
+    unsigned char **live = (unsigned char **)calloc(slots, sizeof(unsigned char *));
+    size_t *sizes = (size_t *)calloc(slots, sizeof(size_t));
+    long long failures = 0, corrupted = 0;
+    if (live == NULL || sizes == NULL) {
+        free(live);
+        free(sizes);
+        buddyDestroy(&allocator);
+        return -1;
+    }
+    srand(1);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < operations; i++) {
+        int slot = rand() % slots;
+        if (live[slot] != NULL) {
+            if (live[slot][0] != (unsigned char)slot || live[slot][sizes[slot] - 1] != (unsigned char)slot) corrupted++;
+            buddyFree(&allocator, live[slot]);
+            live[slot] = NULL;
+        } else {
+            sizes[slot] = (size_t)(rand() % 8 == 0 ? rand() % 4096 : rand() % 256) + 1;
+            live[slot] = (unsigned char *)buddyAlloc(&allocator, sizes[slot]);
+            if (live[slot] == NULL) {
+                failures++;
+            } else {
+                live[slot][0] = live[slot][sizes[slot] - 1] = (unsigned char)slot;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    for (int slot = 0; slot < slots; slot++) buddyFree(&allocator, live[slot]);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("%d random operations: %.1f ns each, %lld allocations failed, %lld blocks corrupted\n",
+           operations, seconds * 1e9 / operations, failures, corrupted);
+    printf("After freeing everything the arena is %s\n",
+           allocator.freeCounts[allocator.maxOrder] == 1 ? "one block again" : "still fragmented");
+
+    free(live);
+    free(sizes);
+    buddyDestroy(&allocator);
+    return 0;
+}
 
-    // Print the memory tree
-    printMemoryTree(head, 0);
-    if(ptr1 != NULL){
-        buddyMerge(ptr1);
-        printMemoryTree(head, 0);
+static size_t residentBytes() {
+    FILE *file = fopen("/proc/self/statm", "r");
+    unsigned long long size, resident = 0;
+
+    if (file == NULL) return 0;
+    if (fscanf(file, "%llu %llu", &size, &resident) != 2) resident = 0;
+    fclose(file);
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static double microsecondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+int buddyLargeArenaDemo() {
+    const size_t arenaSize = (size_t)64 << 30;
+    const int smallBlocks = 100000;
+    const int hugeBlocks = 16;
+    BuddyAllocator allocator;
+    struct timespec start;
+
+    // Reserving 64 GiB only maps address space; blocks of 2 MiB and up are advised to use huge pages
+    size_t residentBefore = residentBytes();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (buddyReserve(&allocator, arenaSize, BUDDY_MIN_ORDER, 21) < 0) return -1;
+    printf("Reserved a %zu GiB arena in %.1f us, %zu bytes committed\n",
+           allocator.size >> 30, microsecondsSince(&start), allocator.committedBytes);
+
+    void *giant[4];
+    void **small = (void **)calloc(smallBlocks, sizeof(void *));
+    void *huge[hugeBlocks];
+    if (small == NULL) {
+        buddyDestroy(&allocator);
+        return -1;
+    }
+
+    // One byte touched per block: only the pages written to become resident
+    for (int i = 0; i < 4; i++) {
+        giant[i] = buddyAlloc(&allocator, (size_t)1 << 30);
+        if (giant[i] != NULL) ((unsigned char *)giant[i])[0] = 1;
+    }
+    for (int i = 0; i < smallBlocks; i++) {
+        small[i] = buddyAlloc(&allocator, 64);
+        if (small[i] != NULL) ((unsigned char *)small[i])[0] = 1;
     }
-    if(ptr2 != NULL){
-        buddyMerge(ptr2);
-        printMemoryTree(head, 0);
+    for (int i = 0; i < hugeBlocks; i++) {
+        huge[i] = buddyAlloc(&allocator, (size_t)2 << 20);
+        if (huge[i] != NULL) memset(huge[i], 1, (size_t)2 << 20);
     }
+    printf("4 x 1 GiB, %d x 64 B and %d x 2 MiB blocks: %zu MiB committed, %zu MiB resident, %zu GiB free\n",
+           smallBlocks, hugeBlocks, allocator.committedBytes >> 20,
+           (residentBytes() - residentBefore) >> 20, allocator.freeBytes >> 30);
 
+    for (int i = 0; i < 4; i++) buddyFree(&allocator, giant[i]);
+    for (int i = 0; i < smallBlocks; i++) buddyFree(&allocator, small[i]);
+    for (int i = 0; i < hugeBlocks; i++) buddyFree(&allocator, huge[i]);
+    printf("After freeing everything the arena is %s\n",
+           allocator.freeCounts[allocator.maxOrder] == 1 ? "one block again" : "still fragmented");
 
+    free(small);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    buddyDestroy(&allocator);
+    printf("Released the arena in %.1f us\n", microsecondsSince(&start));
     return 0;
 }
@@ -0,0 +1,403 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Buddy allocator that threads share without a lock. It has the same block
+    layout as buddy.c, but the free lists and the buddy-free state are changed
+    only by compare-and-swap:
+        - Each order's free list is a Treiber stack of tree nodes. The head
+          carries a tag that is bumped on every change, so a node that is
+          popped and pushed again between a thread's read and its CAS (ABA)
+          fails that CAS. The links live in a side array rather than in the
+          free blocks, because a block can be handed out while its node is
+          still on a stack.
+        - Each node has a state byte with two bits. LISTED means the node is on
+          its stack, and AVAILABLE means the block is free. Allocation pops a
+          node and claims it by clearing both bits. A node whose AVAILABLE bit
+          is already gone is a stale entry and is dropped.
+        - Coalescing claims the buddy by clearing only its AVAILABLE bit. The
+          buddy's stack entry is then stale, so merging never has to unlink
+          anything. Freeing a block whose node is still LISTED sets AVAILABLE
+          again instead of pushing it a second time.
+    If two buddies are freed at the same moment, each can miss the other. A
+    freed block therefore looks at its buddy again after publishing itself.
+    Only the thread that sets the parent's merging flag may then take both
+    blocks back. If both threads tried, each could hold its own block and
+    fail to claim the other, and the pair would stay split for good. The
+    losing thread leaves its block published, and the winner merges it. A
+    winner that cannot claim the buddy gives its block back, drops the flag
+    and looks again. Allocation can fail while other threads hold blocks they
+    are splitting, even though the memory would fit later.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "buddy-allocator.h"
+
+#define LISTED 1
+#define AVAILABLE 2
+#define NO_ORDER 0xFF
+
+static size_t lockFreeNode(const LockFreeBuddy *allocator, size_t offset, int order) {
+    return ((size_t)1 << (allocator->maxOrder - order)) - 1 + (offset >> order);
+}
+
+static size_t nodeOffset(const LockFreeBuddy *allocator, size_t node, int order) {
+    return (node + 1 - ((size_t)1 << (allocator->maxOrder - order))) << order;
+}
+
+static void pushNode(LockFreeBuddy *allocator, size_t node, int order) {
+    uint64_t *head = &allocator->lists[order].head;
+    uint64_t old = __atomic_load_n(head, __ATOMIC_RELAXED);
+    uint64_t new;
+
+    do {
+        __atomic_store_n(&allocator->next[node], (uint32_t)old, __ATOMIC_RELAXED);
+        new = ((old >> 32) + 1) << 32 | (uint64_t)(node + 1);
+    } while (!__atomic_compare_exchange_n(head, &old, new, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+// Node + 1, or 0 if the stack is empty
+static size_t popNode(LockFreeBuddy *allocator, int order) {
+    uint64_t *head = &allocator->lists[order].head;
+    uint64_t old = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+
+    while ((uint32_t)old != 0) {
+        // next may be stale if another thread already popped the node; the tag then fails the CAS
+        uint32_t next = __atomic_load_n(&allocator->next[(uint32_t)old - 1], __ATOMIC_RELAXED);
+        uint64_t new = ((old >> 32) + 1) << 32 | next;
+        if (__atomic_compare_exchange_n(head, &old, new, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) break;
+    }
+    return (uint32_t)old;
+}
+
+// Publish a free block: set AVAILABLE on a node still on its stack, otherwise push it
+static void makeAvailable(LockFreeBuddy *allocator, size_t node, int order) {
+    unsigned char *state = &allocator->state[node];
+    unsigned char old = __atomic_load_n(state, __ATOMIC_RELAXED);
+
+    for (;;) {
+        unsigned char new = (old & LISTED) ? (unsigned char)(old | AVAILABLE) : (unsigned char)(LISTED | AVAILABLE);
+        if (__atomic_compare_exchange_n(state, &old, new, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            if (!(old & LISTED)) pushNode(allocator, node, order);
+            return;
+        }
+    }
+}
+
+// Take a free block that is not on top of a stack, leaving a stale entry
+static int claimNode(LockFreeBuddy *allocator, size_t node) {
+    unsigned char expected = LISTED | AVAILABLE;
+    return __atomic_compare_exchange_n(&allocator->state[node], &expected, LISTED, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+// Pop nodes until one can be claimed; stale ones leave the stack for good
+static int takeBlock(LockFreeBuddy *allocator, int order, size_t *offset) {
+    size_t entry;
+
+    while ((entry = popNode(allocator, order)) != 0) {
+        unsigned char *state = &allocator->state[entry - 1];
+        unsigned char old = __atomic_exchange_n(state, 0, __ATOMIC_ACQ_REL);
+        if (old & AVAILABLE) {
+            *offset = nodeOffset(allocator, entry - 1, order);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int lockFreeBuddyInit(LockFreeBuddy *allocator, void *memory, size_t size, int minOrder) {
+    memset(allocator, 0, sizeof(*allocator));
+    if (minOrder < 0 || minOrder > BUDDY_MAX_ORDER) {
+        printf("Invalid minimum block order %d\n", minOrder);
+        return -1;
+    }
+    size &= ~(((size_t)1 << minOrder) - 1);
+    int maxOrder = size <= 1 ? 0 : 64 - __builtin_clzll((unsigned long long)(size - 1));
+    // Node numbers, plus one, must fit the low 32 bits of a stack head
+    if (size == 0 || maxOrder > BUDDY_MAX_ORDER || maxOrder - minOrder > 30) {
+        printf("Invalid arena size %zu\n", size);
+        return -1;
+    }
+    allocator->size = size;
+    allocator->minOrder = minOrder;
+    allocator->maxOrder = maxOrder;
+
+    size_t nodes = ((size_t)1 << (maxOrder - minOrder + 1)) - 1;
+    size_t leaves = size >> minOrder;
+    allocator->state = (unsigned char *)calloc(nodes, 1);
+    allocator->next = (uint32_t *)calloc(nodes, sizeof(uint32_t));
+    allocator->merging = (unsigned char *)calloc(nodes, 1);
+    allocator->orders = (unsigned char *)malloc(leaves);
+    if (memory == NULL) {
+        if (posix_memalign(&memory, 4096, size) != 0) memory = NULL;
+        allocator->ownsArena = 1;
+    }
+    allocator->arena = (unsigned char *)memory;
+    if (allocator->state == NULL || allocator->next == NULL || allocator->merging == NULL || allocator->orders == NULL ||
+        allocator->arena == NULL) {
+        printf("Out of memory for the lock-free buddy allocator\n");
+        lockFreeBuddyDestroy(allocator);
+        return -1;
+    }
+    memset(allocator->orders, NO_ORDER, leaves);
+
+    // Same covering as buddyInit
+    size_t offset = 0;
+    while (offset < size) {
+        int order = 63 - __builtin_clzll((unsigned long long)(size - offset));
+        if (offset != 0 && __builtin_ctzll((unsigned long long)offset) < order) {
+            order = __builtin_ctzll((unsigned long long)offset);
+        }
+        makeAvailable(allocator, lockFreeNode(allocator, offset, order), order);
+        offset += (size_t)1 << order;
+    }
+    return 0;
+}
+
+void *lockFreeBuddyAlloc(LockFreeBuddy *allocator, size_t size) {
+    if (size > (size_t)1 << allocator->maxOrder) return NULL;
+    int order = size <= 1 ? 0 : 64 - __builtin_clzll((unsigned long long)(size - 1));
+    if (order < allocator->minOrder) order = allocator->minOrder;
+
+    size_t offset;
+    int k = order;
+    while (k <= allocator->maxOrder && !takeBlock(allocator, k, &offset)) k++;
+    if (k > allocator->maxOrder) return NULL;
+
+    while (k > order) {
+        k--;
+        makeAvailable(allocator, lockFreeNode(allocator, offset + ((size_t)1 << k), k), k);
+    }
+    __atomic_store_n(&allocator->orders[offset >> allocator->minOrder], (unsigned char)order, __ATOMIC_RELAXED);
+    return allocator->arena + offset;
+}
+
+// The buddy may have been freed while node was being published. Returns 1 if both are taken
+// back for merging, 0 if node is left published. A thread that loses the parent's merging flag
+// returns at once: the holder has not looked at node yet, or will look again after dropping it.
+static int mergePublished(LockFreeBuddy *allocator, size_t node, size_t buddy, size_t offset, int order) {
+    unsigned char *merging = &allocator->merging[lockFreeNode(allocator, offset & ~((size_t)1 << order), order + 1)];
+
+    for (;;) {
+        // makeAvailable publishes with a sequentially consistent CAS, so this read cannot move before
+        // it; otherwise two threads could each miss the block the other just published
+        if (!(__atomic_load_n(&allocator->state[buddy], __ATOMIC_SEQ_CST) & AVAILABLE)) return 0;
+        if (__atomic_exchange_n(merging, 1, __ATOMIC_SEQ_CST)) return 0;
+        if (!claimNode(allocator, node)) { // Allocated again in the meantime
+            __atomic_store_n(merging, 0, __ATOMIC_SEQ_CST);
+            return 0;
+        }
+        if (claimNode(allocator, buddy)) {
+            __atomic_store_n(merging, 0, __ATOMIC_SEQ_CST);
+            return 1;
+        }
+        makeAvailable(allocator, node, order);
+        __atomic_store_n(merging, 0, __ATOMIC_SEQ_CST);
+    }
+}
+
+int lockFreeBuddyFree(LockFreeBuddy *allocator, void *pointer) {
+    if (pointer == NULL) return 0;
+
+    size_t offset = (size_t)((unsigned char *)pointer - allocator->arena);
+    if ((unsigned char *)pointer < allocator->arena || offset >= allocator->size ||
+        (offset & (((size_t)1 << allocator->minOrder) - 1)) != 0) {
+        printf("lockFreeBuddyFree: %p is not in the arena\n", pointer);
+        return -1;
+    }
+    // Taking the order out also catches a second free of the same block
+    int order = __atomic_exchange_n(&allocator->orders[offset >> allocator->minOrder], NO_ORDER, __ATOMIC_ACQ_REL);
+    if (order == NO_ORDER) {
+        printf("lockFreeBuddyFree: %p is not an allocated block\n", pointer);
+        return -1;
+    }
+
+    for (;;) {
+        size_t buddy = lockFreeNode(allocator, offset ^ ((size_t)1 << order), order);
+        if (order < allocator->maxOrder && claimNode(allocator, buddy)) {
+            offset &= ~((size_t)1 << order);
+            order++;
+            continue;
+        }
+
+        size_t node = lockFreeNode(allocator, offset, order);
+        makeAvailable(allocator, node, order);
+        if (order == allocator->maxOrder || !mergePublished(allocator, node, buddy, offset, order)) return 0;
+        offset &= ~((size_t)1 << order);
+        order++;
+    }
+}
+
+size_t lockFreeBuddyFreeBytes(const LockFreeBuddy *allocator, size_t *blocks, size_t *largest) {
+    size_t bytes = 0;
+    *blocks = 0;
+    *largest = 0;
+    for (int order = allocator->minOrder; order <= allocator->maxOrder; order++) {
+        size_t first = ((size_t)1 << (allocator->maxOrder - order)) - 1;
+        for (size_t node = first; node < 2 * first + 1; node++) {
+            if (allocator->state[node] & AVAILABLE) {
+                bytes += (size_t)1 << order;
+                (*blocks)++;
+                *largest = (size_t)1 << order;
+            }
+        }
+    }
+    return bytes;
+}
+
+void lockFreeBuddyDestroy(LockFreeBuddy *allocator) {
+    if (allocator->ownsArena) free(allocator->arena);
+    free(allocator->state);
+    free(allocator->next);
+    free(allocator->merging);
+    free(allocator->orders);
+    allocator->arena = NULL;
+    allocator->state = NULL;
+    allocator->next = NULL;
+    allocator->merging = NULL;
+    allocator->orders = NULL;
+}
+
+// Stress test: threads allocate and free at random and check that no block is shared
+typedef struct {
+    LockFreeBuddy *lockFree; // NULL to use the locked buddy allocator
+    BuddyAllocator *buddy;
+    pthread_mutex_t *lock;
+    int operations;
+    unsigned seed;
+    long long corrupted;
+    long long failures;
+} StressWorker;
+
+static void *stressWorker(void *arg) {
+    StressWorker *worker = (StressWorker *)arg;
+    uint64_t *live[256] = {NULL};
+    size_t words[256];
+    unsigned x = worker->seed;
+
+    for (int n = 0; n < worker->operations; n++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        int slot = x % 256;
+        uint64_t signature = (uint64_t)worker->seed << 32 | (uint64_t)slot;
+        if (live[slot] != NULL) {
+            if (live[slot][0] != signature || live[slot][words[slot] - 1] != signature) worker->corrupted++;
+            if (worker->lockFree != NULL) {
+                lockFreeBuddyFree(worker->lockFree, live[slot]);
+            } else {
+                pthread_mutex_lock(worker->lock);
+                buddyFree(worker->buddy, live[slot]);
+                pthread_mutex_unlock(worker->lock);
+            }
+            live[slot] = NULL;
+        } else {
+            // Mostly small blocks, with an occasional large one to drive deep splits and merges
+            size_t size = (x >> 8) % 64 == 0 ? 4096 + (x >> 14) % 61440 : 16 + (x >> 8) % 1009;
+            words[slot] = size / sizeof(uint64_t);
+            if (worker->lockFree != NULL) {
+                live[slot] = (uint64_t *)lockFreeBuddyAlloc(worker->lockFree, size);
+            } else {
+                pthread_mutex_lock(worker->lock);
+                live[slot] = (uint64_t *)buddyAlloc(worker->buddy, size);
+                pthread_mutex_unlock(worker->lock);
+            }
+            if (live[slot] == NULL) {
+                worker->failures++;
+            } else {
+                live[slot][0] = live[slot][words[slot] - 1] = signature;
+            }
+        }
+    }
+    for (int slot = 0; slot < 256; slot++) {
+        if (live[slot] == NULL) continue;
+        if (worker->lockFree != NULL) {
+            lockFreeBuddyFree(worker->lockFree, live[slot]);
+        } else {
+            pthread_mutex_lock(worker->lock);
+            buddyFree(worker->buddy, live[slot]);
+            pthread_mutex_unlock(worker->lock);
+        }
+    }
+    return NULL;
+}
+
+int lockFreeBuddyDemo() {
+    const int operations = 400000; // Per thread
+    const size_t arenaSize = 256 << 20;
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    StressWorker workers[32];
+    pthread_t threads[32];
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    printf("Buddy allocator stress test, %d operations per thread, Mops/s\n", operations);
+    printf("%8s %14s %14s  %s\n", "threads", "buddy + lock", "lock-free", "check");
+    for (int t = 0; t < 6; t++) {
+        double rate[2];
+        long long corrupted = 0, failures = 0;
+        size_t freeBytes = 0, freeBlocks = 0, largest = 0;
+
+        for (int useLockFree = 0; useLockFree < 2; useLockFree++) {
+            LockFreeBuddy lockFree;
+            BuddyAllocator buddy;
+            struct timespec start, end;
+            int status = useLockFree ? lockFreeBuddyInit(&lockFree, NULL, arenaSize, BUDDY_MIN_ORDER)
+                                     : buddyInit(&buddy, NULL, arenaSize, BUDDY_MIN_ORDER);
+            if (status < 0) return -1;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int i = 0; i < threadCounts[t]; i++) {
+                workers[i] = (StressWorker){useLockFree ? &lockFree : NULL, &buddy, &lock, operations, 2463534242u + i * 7919u, 0, 0};
+                pthread_create(&threads[i], NULL, stressWorker, &workers[i]);
+            }
+            for (int i = 0; i < threadCounts[t]; i++) {
+                pthread_join(threads[i], NULL);
+                corrupted += workers[i].corrupted;
+                failures += workers[i].failures;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+            rate[useLockFree] = (double)operations * threadCounts[t] / seconds / 1e6;
+            if (useLockFree) {
+                freeBytes = lockFreeBuddyFreeBytes(&lockFree, &freeBlocks, &largest);
+                lockFreeBuddyDestroy(&lockFree);
+            } else {
+                buddyDestroy(&buddy);
+            }
+        }
+        printf("%8d %14.1f %14.1f  %s, %zu free block%s, %lld corrupted, %lld failed\n", threadCounts[t], rate[0], rate[1],
+               freeBytes == arenaSize ? "all memory back" : "memory lost", freeBlocks, freeBlocks == 1 ? "" : "s",
+               corrupted, failures);
+    }
+    return 0;
+}
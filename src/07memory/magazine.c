@@ -0,0 +1,347 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Magazine caches in front of the buddy allocator, after Bonwick and Adams'
+    magazine layer for the slab allocator. Each thread holds two magazines
+    (arrays of up to MAGAZINE_ROUNDS free blocks) for every small order:
+        - alloc pops from the loaded magazine, swaps in the previous one if
+          the loaded one is empty, and otherwise trades its empty magazine for
+          a full one at the order's depot,
+        - free pushes onto the loaded magazine, swaps in the previous one if
+          the loaded one is full, and otherwise trades its full magazine for an
+          empty one at the depot.
+    The previous magazine is always full or empty, so a thread that alternates
+    allocations and frees around a magazine boundary does not go to the depot
+    on every call. Only the depot exchanges take a lock, one per order, and
+    only a depot miss or a large block reaches the buddy allocator, which sits
+    behind its own lock. A depot holding MAGAZINE_DEPOT_LIMIT full magazines
+    gives the blocks of the next one back to the buddy allocator, so cached
+    memory stays bounded.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "buddy-allocator.h"
+
+typedef struct {
+    MagazineAllocator *allocator;
+    Magazine *loaded[MAGAZINE_ORDERS];
+    Magazine *previous[MAGAZINE_ORDERS]; // Full, empty, or NULL
+} MagazineThreadCache;
+
+static void *lockedBuddyAlloc(MagazineAllocator *allocator, size_t size) {
+    pthread_mutex_lock(&allocator->buddyLock);
+    void *pointer = buddyAlloc(&allocator->buddy, size);
+    allocator->buddyCalls++;
+    pthread_mutex_unlock(&allocator->buddyLock);
+    return pointer;
+}
+
+static int lockedBuddyFree(MagazineAllocator *allocator, void *pointer) {
+    pthread_mutex_lock(&allocator->buddyLock);
+    int status = buddyFree(&allocator->buddy, pointer);
+    allocator->buddyCalls++;
+    pthread_mutex_unlock(&allocator->buddyLock);
+    return status;
+}
+
+// Return a magazine's blocks to the buddy allocator under one lock hold
+static void drainMagazine(MagazineAllocator *allocator, Magazine *magazine) {
+    pthread_mutex_lock(&allocator->buddyLock);
+    while (magazine->rounds > 0) buddyFree(&allocator->buddy, magazine->blocks[--magazine->rounds]);
+    allocator->buddyCalls++;
+    pthread_mutex_unlock(&allocator->buddyLock);
+}
+
+static void flushCache(MagazineThreadCache *cache) {
+    for (int i = 0; i < MAGAZINE_ORDERS; i++) {
+        Magazine *magazines[2] = {cache->loaded[i], cache->previous[i]};
+        for (int m = 0; m < 2; m++) {
+            if (magazines[m] == NULL) continue;
+            drainMagazine(cache->allocator, magazines[m]);
+            free(magazines[m]);
+        }
+        cache->loaded[i] = cache->previous[i] = NULL;
+    }
+}
+
+// pthread key destructor, run when a thread that used the allocator exits
+static void releaseThreadCache(void *value) {
+    MagazineThreadCache *cache = (MagazineThreadCache *)value;
+    flushCache(cache);
+    free(cache);
+}
+
+static MagazineThreadCache *threadCache(MagazineAllocator *allocator) {
+    MagazineThreadCache *cache = (MagazineThreadCache *)pthread_getspecific(allocator->threadKey);
+    if (cache == NULL) {
+        cache = (MagazineThreadCache *)calloc(1, sizeof(MagazineThreadCache));
+        if (cache == NULL) return NULL;
+        cache->allocator = allocator;
+        if (pthread_setspecific(allocator->threadKey, cache) != 0) {
+            free(cache);
+            return NULL;
+        }
+    }
+    return cache;
+}
+
+static void swapMagazines(MagazineThreadCache *cache, int i) {
+    Magazine *magazine = cache->loaded[i];
+    cache->loaded[i] = cache->previous[i];
+    cache->previous[i] = magazine;
+}
+
+int magazineInit(MagazineAllocator *allocator, void *memory, size_t size, int minOrder) {
+    memset(allocator, 0, sizeof(*allocator));
+    if (buddyInit(&allocator->buddy, memory, size, minOrder) < 0) return -1;
+    if (pthread_key_create(&allocator->threadKey, releaseThreadCache) != 0) {
+        printf("Out of thread keys for the magazine allocator\n");
+        buddyDestroy(&allocator->buddy);
+        return -1;
+    }
+    pthread_mutex_init(&allocator->buddyLock, NULL);
+    for (int i = 0; i < MAGAZINE_ORDERS; i++) pthread_mutex_init(&allocator->depots[i].lock, NULL);
+    return 0;
+}
+
+void *magazineAlloc(MagazineAllocator *allocator, size_t size) {
+    int order = size <= 1 ? 0 : 64 - __builtin_clzll((unsigned long long)(size - 1));
+    if (order < allocator->buddy.minOrder) order = allocator->buddy.minOrder;
+    int i = order - allocator->buddy.minOrder;
+    MagazineThreadCache *cache;
+
+    if (i >= MAGAZINE_ORDERS || (cache = threadCache(allocator)) == NULL) return lockedBuddyAlloc(allocator, size);
+
+    Magazine *loaded = cache->loaded[i];
+    if (loaded != NULL && loaded->rounds > 0) return loaded->blocks[--loaded->rounds];
+    if (cache->previous[i] != NULL && cache->previous[i]->rounds > 0) {
+        swapMagazines(cache, i);
+        return cache->loaded[i]->blocks[--cache->loaded[i]->rounds];
+    }
+
+    // Both magazines are empty (or missing): trade the previous one for a full one
+    MagazineDepot *depot = &allocator->depots[i];
+    pthread_mutex_lock(&depot->lock);
+    Magazine *full = depot->full;
+    if (full != NULL) {
+        depot->full = full->next;
+        depot->fullCount--;
+        depot->exchanges++;
+        if (cache->previous[i] != NULL) {
+            cache->previous[i]->next = depot->empty;
+            depot->empty = cache->previous[i];
+        }
+    }
+    pthread_mutex_unlock(&depot->lock);
+
+    if (full == NULL) return lockedBuddyAlloc(allocator, (size_t)1 << order);
+    cache->previous[i] = cache->loaded[i];
+    cache->loaded[i] = full;
+    return full->blocks[--full->rounds];
+}
+
+int magazineFree(MagazineAllocator *allocator, void *pointer) {
+    BuddyAllocator *buddy = &allocator->buddy;
+    MagazineThreadCache *cache;
+
+    if (pointer == NULL) return 0;
+    if ((unsigned char *)pointer < buddy->arena || (unsigned char *)pointer >= buddy->arena + buddy->size) {
+        printf("magazineFree: %p is not in the arena\n", pointer);
+        return -1;
+    }
+    int i = __builtin_ctzll((unsigned long long)buddyBlockSize(buddy, pointer)) - buddy->minOrder;
+    if (i >= MAGAZINE_ORDERS || (cache = threadCache(allocator)) == NULL) return lockedBuddyFree(allocator, pointer);
+
+    Magazine *loaded = cache->loaded[i];
+    if (loaded != NULL && loaded->rounds < MAGAZINE_ROUNDS) {
+        loaded->blocks[loaded->rounds++] = pointer;
+        return 0;
+    }
+    if (cache->previous[i] != NULL && cache->previous[i]->rounds == 0) {
+        swapMagazines(cache, i);
+        cache->loaded[i]->blocks[cache->loaded[i]->rounds++] = pointer;
+        return 0;
+    }
+
+    // Both magazines are full (or missing): hand the previous one in and take an empty one
+    MagazineDepot *depot = &allocator->depots[i];
+    Magazine *full = cache->previous[i];
+    pthread_mutex_lock(&depot->lock);
+    Magazine *empty = depot->empty;
+    if (empty != NULL) depot->empty = empty->next;
+    if (full != NULL && depot->fullCount < MAGAZINE_DEPOT_LIMIT) {
+        full->next = depot->full;
+        depot->full = full;
+        depot->fullCount++;
+        depot->exchanges++;
+        full = NULL;
+    }
+    pthread_mutex_unlock(&depot->lock);
+
+    if (full != NULL) {
+        // The depot is at its limit, so these blocks go back to the buddy allocator
+        drainMagazine(allocator, full);
+        if (empty == NULL) {
+            empty = full;
+        } else {
+            free(full);
+        }
+    }
+    if (empty == NULL) {
+        empty = (Magazine *)malloc(sizeof(Magazine));
+        if (empty == NULL) {
+            cache->previous[i] = NULL; // Handed to the depot above
+            return lockedBuddyFree(allocator, pointer);
+        }
+    }
+    empty->rounds = 0;
+    cache->previous[i] = cache->loaded[i];
+    cache->loaded[i] = empty;
+    empty->blocks[empty->rounds++] = pointer;
+    return 0;
+}
+
+void magazineFlushThread(MagazineAllocator *allocator) {
+    MagazineThreadCache *cache = (MagazineThreadCache *)pthread_getspecific(allocator->threadKey);
+    if (cache == NULL) return;
+    pthread_setspecific(allocator->threadKey, NULL);
+    releaseThreadCache(cache);
+}
+
+void magazineDestroy(MagazineAllocator *allocator) {
+    magazineFlushThread(allocator);
+    for (int i = 0; i < MAGAZINE_ORDERS; i++) {
+        Magazine *lists[2] = {allocator->depots[i].full, allocator->depots[i].empty};
+        for (int l = 0; l < 2; l++) {
+            while (lists[l] != NULL) {
+                Magazine *next = lists[l]->next;
+                free(lists[l]);
+                lists[l] = next;
+            }
+        }
+        pthread_mutex_destroy(&allocator->depots[i].lock);
+    }
+    pthread_key_delete(allocator->threadKey);
+    pthread_mutex_destroy(&allocator->buddyLock);
+    buddyDestroy(&allocator->buddy);
+}
+
+// Demo: the same workload through the magazines and through one lock around the buddy allocator
+typedef struct {
+    MagazineAllocator *allocator;
+    int useMagazines;
+    int operations;
+    unsigned seed;
+    long long corrupted;
+    long long failures;
+} MagazineWorker;
+
+static void *magazineWorker(void *arg) {
+    MagazineWorker *worker = (MagazineWorker *)arg;
+    unsigned char *live[256] = {NULL};
+    size_t sizes[256];
+    unsigned x = worker->seed;
+    unsigned char mark = (unsigned char)worker->seed;
+
+    for (int n = 0; n < worker->operations; n++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        int slot = x % 256;
+        if (live[slot] != NULL) {
+            if (live[slot][0] != mark || live[slot][sizes[slot] - 1] != mark) worker->corrupted++;
+            if (worker->useMagazines) {
+                magazineFree(worker->allocator, live[slot]);
+            } else {
+                lockedBuddyFree(worker->allocator, live[slot]);
+            }
+            live[slot] = NULL;
+        } else {
+            sizes[slot] = 16 + (x >> 8) % 1009;
+            live[slot] = worker->useMagazines ? (unsigned char *)magazineAlloc(worker->allocator, sizes[slot])
+                                              : (unsigned char *)lockedBuddyAlloc(worker->allocator, sizes[slot]);
+            if (live[slot] == NULL) {
+                worker->failures++;
+            } else {
+                live[slot][0] = live[slot][sizes[slot] - 1] = mark;
+            }
+        }
+    }
+    for (int slot = 0; slot < 256; slot++) {
+        if (worker->useMagazines) {
+            magazineFree(worker->allocator, live[slot]);
+        } else {
+            lockedBuddyFree(worker->allocator, live[slot]);
+        }
+    }
+    return NULL;
+}
+
+int magazineDemo() {
+    const int operations = 400000; // Per thread
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    MagazineWorker workers[32];
+    pthread_t threads[32];
+
+    printf("Allocation throughput, %d operations per thread, Mops/s\n", operations);
+    printf("%8s %14s %14s\n", "threads", "buddy + lock", "magazines");
+    for (int t = 0; t < 6; t++) {
+        double rate[2];
+        long long corrupted = 0, failures = 0;
+        for (int useMagazines = 0; useMagazines < 2; useMagazines++) {
+            MagazineAllocator allocator;
+            struct timespec start, end;
+            if (magazineInit(&allocator, NULL, 64 << 20, BUDDY_MIN_ORDER) < 0) return -1;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int i = 0; i < threadCounts[t]; i++) {
+                workers[i] = (MagazineWorker){&allocator, useMagazines, operations, 2463534242u + i * 7919u, 0, 0};
+                pthread_create(&threads[i], NULL, magazineWorker, &workers[i]);
+            }
+            for (int i = 0; i < threadCounts[t]; i++) {
+                pthread_join(threads[i], NULL);
+                corrupted += workers[i].corrupted;
+                failures += workers[i].failures;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+
+            double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+            rate[useMagazines] = (double)operations * threadCounts[t] / seconds / 1e6;
+            if (allocator.depots[0].fullCount > MAGAZINE_DEPOT_LIMIT) corrupted++;
+            magazineDestroy(&allocator);
+        }
+        printf("%8d %14.1f %14.1f%s\n", threadCounts[t], rate[0], rate[1],
+               corrupted + failures > 0 ? "  (errors)" : "");
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    ARC, Adaptive Replacement Cache (Megiddo and Modha, 2003).
+    Resident pages are kept on two LRU lists: T1 for pages seen once recently
+    and T2 for pages seen at least twice. Two ghost lists, B1 and B2, remember
+    the pages recently evicted from T1 and T2 (only the page numbers). A fault
+    on a page in B1 means T1 was too small, so the target size p of T1 grows.
+    A fault on a page in B2 shrinks it. A long sequential scan only passes
+    through T1 and cannot push the frequently used pages out of T2.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include "page-policy.h"
+
+#define ARC_T1 1
+#define ARC_T2 2
+#define ARC_B1 3
+#define ARC_B2 4
+#define ARC_PREFETCHED 1 // Read ahead and not referenced yet
+
+static PageList *arcList(ArcSim *sim, int list) {
+    switch (list) {
+        case ARC_T1: return &sim->t1;
+        case ARC_T2: return &sim->t2;
+        case ARC_B1: return &sim->b1;
+        default: return &sim->b2;
+    }
+}
+
+static void arcMove(ArcSim *sim, int node, int list) {
+    pageListRemove(&sim->pool, arcList(sim, sim->pool.nodes[node].list), node);
+    sim->pool.nodes[node].list = list;
+    pageListPushHead(&sim->pool, arcList(sim, list), node);
+}
+
+static void arcDrop(ArcSim *sim, PageList *ghosts) {
+    int node = ghosts->tail;
+    pageListRemove(&sim->pool, ghosts, node);
+    nodePoolRelease(&sim->pool, node);
+}
+
+// REPLACE from the paper: demote the LRU page of T1 or T2 to its ghost list.
+// A prefetched page that was never referenced leaves no ghost, as it says nothing about reuse.
+static int arcReplace(ArcSim *sim, int inB2) {
+    int node;
+    if (sim->t1.size > 0 && ((inB2 && sim->t1.size == sim->p) || sim->t1.size > sim->p || sim->t2.size == 0)) {
+        node = sim->t1.tail;
+        if (sim->pool.nodes[node].flags & ARC_PREFETCHED) {
+            int page = sim->pool.nodes[node].page;
+            pageListRemove(&sim->pool, &sim->t1, node);
+            nodePoolRelease(&sim->pool, node);
+            return page;
+        }
+        arcMove(sim, node, ARC_B1);
+    } else {
+        node = sim->t2.tail;
+        arcMove(sim, node, ARC_B2);
+    }
+    return sim->pool.nodes[node].page;
+}
+
+int arcSimInit(ArcSim *sim, int frameCount) {
+    // c resident pages and at most c ghosts, one spare for the page being added
+    if (nodePoolInit(&sim->pool, 2 * frameCount + 1) < 0) return -1;
+    pageListInit(&sim->t1);
+    pageListInit(&sim->t2);
+    pageListInit(&sim->b1);
+    pageListInit(&sim->b2);
+    sim->c = frameCount;
+    sim->p = 0;
+    return 0;
+}
+
+// Case IV from the paper: make room in the directory and put a new page at the head of T1
+static int arcInsert(ArcSim *sim, int page) {
+    int resident = sim->t1.size + sim->t2.size;
+    if (sim->t1.size + sim->b1.size == sim->c) {
+        if (sim->t1.size < sim->c) {
+            arcDrop(sim, &sim->b1);
+            if (resident == sim->c) arcReplace(sim, 0);
+        } else {
+            // B1 is empty and T1 holds the whole cache: drop the LRU page of T1 outright
+            int victim = sim->t1.tail;
+            pageListRemove(&sim->pool, &sim->t1, victim);
+            nodePoolRelease(&sim->pool, victim);
+        }
+    } else {
+        int total = resident + sim->b1.size + sim->b2.size;
+        if (total >= sim->c) {
+            if (total == 2 * sim->c) arcDrop(sim, &sim->b2);
+            if (resident == sim->c) arcReplace(sim, 0);
+        }
+    }
+    int node = nodePoolAlloc(&sim->pool, page);
+    sim->pool.nodes[node].list = ARC_T1;
+    pageListPushHead(&sim->pool, &sim->t1, node);
+    return node;
+}
+
+int arcSimAccess(ArcSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    int list = node != -1 ? sim->pool.nodes[node].list : 0;
+    int resident = sim->t1.size + sim->t2.size;
+
+    // Case I: hit in T1 or T2. The first reference to a prefetched page only counts as being seen once.
+    if (list == ARC_T1 || list == ARC_T2) {
+        if (sim->pool.nodes[node].flags & ARC_PREFETCHED) {
+            sim->pool.nodes[node].flags = 0;
+            arcMove(sim, node, ARC_T1);
+        } else {
+            arcMove(sim, node, ARC_T2);
+        }
+        return 0;
+    }
+
+    // Case II and III: a ghost hit adapts p, then the page goes to T2
+    if (list == ARC_B1 || list == ARC_B2) {
+        if (list == ARC_B1) {
+            int delta = sim->b2.size > sim->b1.size ? sim->b2.size / sim->b1.size : 1;
+            sim->p = sim->p + delta < sim->c ? sim->p + delta : sim->c;
+        } else {
+            int delta = sim->b1.size > sim->b2.size ? sim->b1.size / sim->b2.size : 1;
+            sim->p = sim->p - delta > 0 ? sim->p - delta : 0;
+        }
+        if (resident == sim->c) arcReplace(sim, list == ARC_B2);
+        arcMove(sim, node, ARC_T2);
+        return 1;
+    }
+
+    // Case IV: a page not in any list
+    arcInsert(sim, page);
+    return 1;
+}
+
+// Load a page ahead of use as if it had never been seen: a ghost entry is
+// forgotten without adapting p, and the page goes into T1 marked as prefetched
+int arcSimPrefetch(ArcSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    if (node != -1) {
+        int list = sim->pool.nodes[node].list;
+        if (list == ARC_T1 || list == ARC_T2) return 0;
+        pageListRemove(&sim->pool, arcList(sim, list), node);
+        nodePoolRelease(&sim->pool, node);
+    }
+    node = arcInsert(sim, page);
+    sim->pool.nodes[node].flags = ARC_PREFETCHED;
+    return 1;
+}
+
+int arcSimEvict(ArcSim *sim) {
+    if (sim->t1.size + sim->t2.size == 0) return -1;
+    return arcReplace(sim, 0); // The page stays in the directory as a ghost
+}
+
+int arcSimContains(const ArcSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    return node != -1 && (sim->pool.nodes[node].list == ARC_T1 || sim->pool.nodes[node].list == ARC_T2);
+}
+
+void arcSimFree(ArcSim *sim) {
+    nodePoolFree(&sim->pool);
+}
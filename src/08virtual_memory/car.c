@@ -0,0 +1,196 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    CAR, Clock with Adaptive Replacement (Bansal and Modha, 2004).
+    CAR is ARC with the two resident LRU lists replaced by two clocks, so a
+    hit only sets a reference bit, as in clock.c. T1 holds pages seen once
+    and T2 pages seen again. The head of each list is where its hand points,
+    and new pages join at the tail, just behind the hand. When the hand finds
+    a T1 page with its reference bit set, the page moves to T2 instead of
+    being evicted. B1 and B2 are ARC's ghost lists and adapt the target size
+    p of T1 in the same way.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include "page-policy.h"
+
+#define CAR_T1 1
+#define CAR_T2 2
+#define CAR_B1 3
+#define CAR_B2 4
+#define CAR_REFERENCED 1
+#define CAR_PREFETCHED 2 // Read ahead and not referenced yet
+
+static PageList *carList(CarSim *sim, int list) {
+    switch (list) {
+        case CAR_T1: return &sim->t1;
+        case CAR_T2: return &sim->t2;
+        case CAR_B1: return &sim->b1;
+        default: return &sim->b2;
+    }
+}
+
+static void carMove(CarSim *sim, int node, int list, int atTail) {
+    pageListRemove(&sim->pool, carList(sim, sim->pool.nodes[node].list), node);
+    sim->pool.nodes[node].list = list;
+    if (atTail) pageListPushTail(&sim->pool, carList(sim, list), node);
+    else pageListPushHead(&sim->pool, carList(sim, list), node);
+}
+
+static void carDrop(CarSim *sim, PageList *ghosts) {
+    int node = ghosts->tail;
+    pageListRemove(&sim->pool, ghosts, node);
+    nodePoolRelease(&sim->pool, node);
+}
+
+// Turn the hands until a page with a clear reference bit is found and demoted to a ghost list
+static int carReplace(CarSim *sim) {
+    while (1) {
+        int target = sim->p > 1 ? sim->p : 1;
+        if (sim->t1.size >= target || sim->t2.size == 0) {
+            int node = sim->t1.head;
+            if (sim->pool.nodes[node].flags & CAR_REFERENCED) {
+                sim->pool.nodes[node].flags = 0;
+                carMove(sim, node, CAR_T2, 1);
+            } else if (sim->pool.nodes[node].flags & CAR_PREFETCHED) {
+                // Never referenced, so it leaves no ghost to adapt p with
+                int page = sim->pool.nodes[node].page;
+                pageListRemove(&sim->pool, &sim->t1, node);
+                nodePoolRelease(&sim->pool, node);
+                return page;
+            } else {
+                carMove(sim, node, CAR_B1, 0);
+                return sim->pool.nodes[node].page;
+            }
+        } else {
+            int node = sim->t2.head;
+            if (sim->pool.nodes[node].flags & CAR_REFERENCED) {
+                sim->pool.nodes[node].flags = 0;
+                carMove(sim, node, CAR_T2, 1);
+            } else {
+                carMove(sim, node, CAR_B2, 0);
+                return sim->pool.nodes[node].page;
+            }
+        }
+    }
+}
+
+int carSimInit(CarSim *sim, int frameCount) {
+    if (nodePoolInit(&sim->pool, 2 * frameCount + 1) < 0) return -1;
+    pageListInit(&sim->t1);
+    pageListInit(&sim->t2);
+    pageListInit(&sim->b1);
+    pageListInit(&sim->b2);
+    sim->c = frameCount;
+    sim->p = 0;
+    return 0;
+}
+
+// A page in no list goes to the tail of T1, just behind the hand
+static int carInsert(CarSim *sim, int page) {
+    if (sim->t1.size + sim->t2.size == sim->c) {
+        carReplace(sim);
+    }
+    // Keep the directory at 2c pages. With a full cache these are the paper's
+    // conditions; the size checks only matter after carSimEvict().
+    if (sim->t1.size + sim->b1.size >= sim->c && sim->b1.size > 0) {
+        carDrop(sim, &sim->b1);
+    } else if (sim->t1.size + sim->t2.size + sim->b1.size + sim->b2.size >= 2 * sim->c && sim->b2.size > 0) {
+        carDrop(sim, &sim->b2);
+    }
+    int node = nodePoolAlloc(&sim->pool, page);
+    sim->pool.nodes[node].list = CAR_T1;
+    pageListPushTail(&sim->pool, &sim->t1, node);
+    return node;
+}
+
+int carSimAccess(CarSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    int list = node != -1 ? sim->pool.nodes[node].list : 0;
+
+    if (list == CAR_T1 || list == CAR_T2) {
+        if (sim->pool.nodes[node].flags & CAR_PREFETCHED) {
+            // The first reference to a prefetched page: it is now a page seen once, just loaded
+            sim->pool.nodes[node].flags = 0;
+            carMove(sim, node, CAR_T1, 1);
+        } else {
+            sim->pool.nodes[node].flags |= CAR_REFERENCED;
+        }
+        return 0;
+    }
+
+    if (list == 0) {
+        carInsert(sim, page);
+        return 1;
+    }
+    if (sim->t1.size + sim->t2.size == sim->c) {
+        carReplace(sim);
+    }
+    if (list == CAR_B1) {
+        int delta = sim->b2.size > sim->b1.size ? sim->b2.size / sim->b1.size : 1;
+        sim->p = sim->p + delta < sim->c ? sim->p + delta : sim->c;
+        sim->pool.nodes[node].flags = 0;
+        carMove(sim, node, CAR_T2, 1);
+    } else {
+        int delta = sim->b1.size > sim->b2.size ? sim->b1.size / sim->b2.size : 1;
+        sim->p = sim->p - delta > 0 ? sim->p - delta : 0;
+        sim->pool.nodes[node].flags = 0;
+        carMove(sim, node, CAR_T2, 1);
+    }
+    return 1;
+}
+
+// Load a page ahead of use as if it had never been seen: a ghost entry is
+// forgotten without adapting p, and the page joins T1 marked as prefetched
+int carSimPrefetch(CarSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    if (node != -1) {
+        int list = sim->pool.nodes[node].list;
+        if (list == CAR_T1 || list == CAR_T2) return 0;
+        pageListRemove(&sim->pool, carList(sim, list), node);
+        nodePoolRelease(&sim->pool, node);
+    }
+    node = carInsert(sim, page);
+    sim->pool.nodes[node].flags = CAR_PREFETCHED;
+    return 1;
+}
+
+int carSimEvict(CarSim *sim) {
+    if (sim->t1.size + sim->t2.size == 0) return -1;
+    return carReplace(sim);
+}
+
+int carSimContains(const CarSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    return node != -1 && (sim->pool.nodes[node].list == CAR_T1 || sim->pool.nodes[node].list == CAR_T2);
+}
+
+void carSimFree(CarSim *sim) {
+    nodePoolFree(&sim->pool);
+}
@@ -0,0 +1,235 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    CLOCK-Pro (Jiang, Chen and Zhang, 2005).
+    All pages sit on one circular list, as in the Clock policy of clock.c, and
+    three hands move around it:
+        - HAND_cold finds the page to evict among the cold resident pages. A
+          cold page whose reference bit is set was reused during its test
+          period and becomes hot instead.
+        - HAND_hot turns hot pages that were not referenced since its last
+          pass into cold ones, keeping the hot pages within their share.
+        - HAND_test ends the test period of evicted pages. An evicted cold page
+          keeps its list entry (without a frame) for a while, so that a quick
+          reuse can be recognised.
+    A fault on a page still in its test period makes it hot and gives cold
+    pages one more frame. A test period that runs out without a reuse takes
+    one away. Scanned pages are only ever cold and leave the list quickly.
+    This follows the simplified form used by most implementations, in which
+    every cold resident page is in its test period.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include "page-policy.h"
+
+#define CP_HOT 1
+#define CP_COLD 2
+#define CP_TEST 3 // Non-resident cold page in its test period
+#define CP_REFERENCED 1
+#define CP_PREFETCHED 2 // Read ahead and not referenced yet
+
+static int nextOnClock(ClockProSim *sim, int node) {
+    int next = sim->pool.nodes[node].next;
+    return next != -1 ? next : sim->clock.head;
+}
+
+// Add a page just behind the hot hand, where the hands reach it last
+static void clockProAdd(ClockProSim *sim, int page, int type) {
+    int node = nodePoolAlloc(&sim->pool, page);
+    sim->pool.nodes[node].list = type;
+    if (sim->handHot == -1) {
+        pageListPushTail(&sim->pool, &sim->clock, node);
+        sim->handHot = sim->handCold = sim->handTest = node;
+    } else {
+        pageListInsertBefore(&sim->pool, &sim->clock, sim->handHot, node);
+    }
+}
+
+static void clockProRemove(ClockProSim *sim, int node) {
+    int next = sim->clock.size > 1 ? nextOnClock(sim, node) : -1;
+    if (sim->handHot == node) sim->handHot = next;
+    if (sim->handCold == node) sim->handCold = next;
+    if (sim->handTest == node) sim->handTest = next;
+    pageListRemove(&sim->pool, &sim->clock, node);
+    nodePoolRelease(&sim->pool, node);
+}
+
+// A test period ran out without a reuse: cold pages get one frame less
+static void endTestPeriod(ClockProSim *sim, int node) {
+    clockProRemove(sim, node);
+    sim->countTest--;
+    if (sim->memCold > 1) sim->memCold--;
+}
+
+// Turn one hot page cold. Test periods of the entries passed on the way end.
+static void runHandHot(ClockProSim *sim) {
+    while (sim->countHot > 0) {
+        int node = sim->handHot;
+        ListNode *entry = &sim->pool.nodes[node];
+
+        if (entry->list == CP_TEST) {
+            endTestPeriod(sim, node); // Moves the hot hand on
+            continue;
+        }
+        sim->handHot = nextOnClock(sim, node);
+        if (entry->list == CP_HOT) {
+            if (entry->flags & CP_REFERENCED) {
+                entry->flags = 0;
+            } else {
+                entry->list = CP_COLD;
+                sim->countHot--;
+                sim->countCold++;
+                return;
+            }
+        }
+    }
+}
+
+// Remove the next entry whose test period is still running
+static void runHandTest(ClockProSim *sim) {
+    while (sim->countTest > 0) {
+        int node = sim->handTest;
+        if (sim->pool.nodes[node].list == CP_TEST) {
+            endTestPeriod(sim, node);
+            return;
+        }
+        sim->handTest = nextOnClock(sim, node);
+    }
+}
+
+// Evict one cold page, promoting the referenced cold pages the hand passes
+static void runHandCold(ClockProSim *sim) {
+    while (1) {
+        if (sim->countCold == 0) runHandHot(sim);
+
+        int node = sim->handCold;
+        ListNode *entry = &sim->pool.nodes[node];
+        sim->handCold = nextOnClock(sim, node);
+        if (entry->list != CP_COLD) continue;
+
+        if (entry->flags & CP_REFERENCED) {
+            // Reused during its test period: promote, and keep hot pages within their share
+            entry->list = CP_HOT;
+            entry->flags = 0;
+            sim->countCold--;
+            sim->countHot++;
+            while (sim->countHot > sim->memMax - sim->memCold) runHandHot(sim);
+        } else if (entry->flags & CP_PREFETCHED) {
+            // Never referenced, so there is no reuse to test for
+            sim->lastEvicted = entry->page;
+            sim->countCold--;
+            clockProRemove(sim, node);
+            return;
+        } else {
+            // Evict, but keep the entry while its test period lasts
+            entry->list = CP_TEST;
+            sim->countCold--;
+            sim->countTest++;
+            sim->lastEvicted = entry->page;
+            while (sim->countTest > sim->memMax) runHandTest(sim);
+            return;
+        }
+    }
+}
+
+static void clockProMakeRoom(ClockProSim *sim) {
+    while (sim->countHot + sim->countCold >= sim->memMax) runHandCold(sim);
+}
+
+int clockProSimInit(ClockProSim *sim, int frameCount) {
+    // Resident pages plus at most as many test entries, and room for one more of each
+    if (nodePoolInit(&sim->pool, 2 * frameCount + 2) < 0) return -1;
+    pageListInit(&sim->clock);
+    sim->handHot = sim->handCold = sim->handTest = -1;
+    sim->memMax = frameCount;
+    sim->memCold = frameCount;
+    sim->countHot = sim->countCold = sim->countTest = 0;
+    sim->lastEvicted = -1;
+    return 0;
+}
+
+int clockProSimAccess(ClockProSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    int type = node != -1 ? sim->pool.nodes[node].list : 0;
+
+    if (type == CP_HOT || type == CP_COLD) {
+        // The first reference to a prefetched page makes it an ordinary cold page
+        if (sim->pool.nodes[node].flags & CP_PREFETCHED) sim->pool.nodes[node].flags = 0;
+        else sim->pool.nodes[node].flags |= CP_REFERENCED;
+        return 0;
+    }
+
+    if (type == CP_TEST) {
+        // Reused soon after eviction: cold pages deserve more memory
+        if (sim->memCold < sim->memMax) sim->memCold++;
+        clockProRemove(sim, node);
+        sim->countTest--;
+        clockProMakeRoom(sim);
+        clockProAdd(sim, page, CP_HOT);
+        sim->countHot++;
+        while (sim->countHot > sim->memMax - sim->memCold) runHandHot(sim);
+    } else {
+        clockProMakeRoom(sim);
+        clockProAdd(sim, page, CP_COLD);
+        sim->countCold++;
+    }
+    return 1;
+}
+
+// Load a page ahead of use as a cold page. A test entry is dropped without
+// giving cold pages another frame, since a prefetch is not a reuse.
+int clockProSimPrefetch(ClockProSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    if (node != -1) {
+        if (sim->pool.nodes[node].list != CP_TEST) return 0;
+        clockProRemove(sim, node);
+        sim->countTest--;
+    }
+    clockProMakeRoom(sim);
+    clockProAdd(sim, page, CP_COLD);
+    sim->pool.nodes[pageIndexFind(&sim->pool.index, page)].flags = CP_PREFETCHED;
+    sim->countCold++;
+    return 1;
+}
+
+int clockProSimEvict(ClockProSim *sim) {
+    int resident = sim->countHot + sim->countCold;
+    if (resident == 0) return -1;
+    runHandCold(sim);
+    return sim->lastEvicted;
+}
+
+int clockProSimContains(const ClockProSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    return node != -1 && (sim->pool.nodes[node].list == CP_HOT || sim->pool.nodes[node].list == CP_COLD);
+}
+
+void clockProSimFree(ClockProSim *sim) {
+    nodePoolFree(&sim->pool);
+}
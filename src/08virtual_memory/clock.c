@@ -32,19 +32,18 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include "page-policy.h"
+#include "page-trace.h"
 
 #define PAGE_SEQ_LEN 12
 #define NUMBER_OF_FRAMES 4
 
-typedef struct {
-    int pageNumber;
-    int useBit;
-} Frame;
-
 void initializeFrames(Frame frames[]) {
     for (int i = 0; i < NUMBER_OF_FRAMES; i++) {
         frames[i].pageNumber = -1; // -1 indicates that the frame is empty
         frames[i].useBit = 0; // Initialize use bit to 0
+        frames[i].modifiedBit = 0;
     }
 }
 
@@ -69,7 +68,7 @@ void displayFrames(Frame frames[]) {
     printf("\n");
 }
 
-void clockPageReplacement(int pages[], Frame frames[]) {
+int clockPageReplacement(int pages[], Frame frames[]) {
     initializeFrames(frames);
 
     int pointer = 0; // Points to the oldest frame
@@ -77,7 +76,8 @@ void clockPageReplacement(int pages[], Frame frames[]) {
 
     for (int i = 0; i < PAGE_SEQ_LEN; i++) {
         int page = pages[i];
-        printf("Processing page: %d\n", page);
+        int evicted = -1;
+        if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("Processing page: %d\n", page);
         int frameIndex = findFrame(frames, page);
 
         if (frameIndex == -1) { // Page fault
@@ -86,6 +86,7 @@ void clockPageReplacement(int pages[], Frame frames[]) {
                 pointer = (pointer + 1) % NUMBER_OF_FRAMES; // Move the pointer to the next frame
             }
             // Replace the page at pointer with the new page
+            evicted = frames[pointer].pageNumber;
             frames[pointer].pageNumber = page;
             frames[pointer].useBit = 1; // Set the use bit
             pointer = (pointer + 1) % NUMBER_OF_FRAMES; // Move the pointer to the next frame
@@ -95,10 +96,15 @@ void clockPageReplacement(int pages[], Frame frames[]) {
             frames[frameIndex].useBit = 1; // Set the use bit since the page was accessed
         }
 
-        displayFrames(frames);
+        if (simOutputMode == SIM_OUTPUT_VERBOSE) {
+            displayFrames(frames);
+        } else if (simOutputMode == SIM_OUTPUT_TRACE) {
+            emitPageEvent(page, frameIndex != -1, evicted, pageFaults < NUMBER_OF_FRAMES ? pageFaults : NUMBER_OF_FRAMES);
+        }
     }
 
-    printf("\nTotal page faults: %d\n", pageFaults);
+    if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("\nTotal page faults: %d\n", pageFaults);
+    return pageFaults;
 }
 
 int clockDemo() {
@@ -110,3 +116,129 @@ int clockDemo() {
 
     return 0;
 }
+
+// Step-by-step Clock with a run-time frame count, used by the trace replay engine
+int clockSimInit(ClockSim *sim, int frameCount) {
+    sim->frames = (Frame *)malloc(sizeof(Frame) * frameCount);
+    if (sim->frames == NULL) return -1;
+    for (int i = 0; i < frameCount; i++) {
+        sim->frames[i].pageNumber = -1;
+        sim->frames[i].useBit = 0;
+        sim->frames[i].modifiedBit = 0;
+    }
+    sim->frameCount = frameCount;
+    sim->pointer = 0;
+    return 0;
+}
+
+int clockSimAccess(ClockSim *sim, int page) {
+    Frame *frames = sim->frames;
+
+    for (int i = 0; i < sim->frameCount; i++) {
+        if (frames[i].pageNumber == page) {
+            frames[i].useBit = 1;
+            return 0;
+        }
+    }
+
+    // Page fault: advance the hand until a frame with a clear use bit is found
+    while (frames[sim->pointer].useBit == 1) {
+        frames[sim->pointer].useBit = 0;
+        sim->pointer = (sim->pointer + 1) % sim->frameCount;
+    }
+    frames[sim->pointer].pageNumber = page;
+    frames[sim->pointer].useBit = 1;
+    sim->pointer = (sim->pointer + 1) % sim->frameCount;
+    return 1;
+}
+
+void clockSimFree(ClockSim *sim) {
+    free(sim->frames);
+    sim->frames = NULL;
+}
+
+// Clock that finds resident pages through a page index; only the hand touches use bits
+int clockHashSimInit(ClockHashSim *sim, int frameCount) {
+    sim->frames = (Frame *)malloc(sizeof(Frame) * frameCount);
+    sim->freeFrames = (int *)malloc(sizeof(int) * frameCount);
+    if (sim->frames == NULL || sim->freeFrames == NULL || pageIndexInit(&sim->index, frameCount) < 0) {
+        free(sim->frames);
+        free(sim->freeFrames);
+        sim->frames = NULL;
+        return -1;
+    }
+    for (int i = 0; i < frameCount; i++) {
+        sim->frames[i].pageNumber = -1;
+        sim->frames[i].useBit = 0;
+        sim->frames[i].modifiedBit = 0;
+        sim->freeFrames[i] = frameCount - 1 - i; // Filled from frame 0 up, as clockPageReplacement() does
+    }
+    sim->freeCount = frameCount;
+    sim->frameCount = frameCount;
+    sim->pointer = 0;
+    return 0;
+}
+
+int clockHashSimAccess(ClockHashSim *sim, int page) {
+    Frame *frames = sim->frames;
+    int frameIndex = pageIndexFind(&sim->index, page);
+
+    if (frameIndex != -1) {
+        frames[frameIndex].useBit = 1;
+        return 0;
+    }
+
+    if (sim->freeCount > 0) {
+        // An empty frame is left alone by the hand, so filling it does not move the hand
+        frameIndex = sim->freeFrames[--sim->freeCount];
+    } else {
+        while (frames[sim->pointer].useBit == 1) {
+            frames[sim->pointer].useBit = 0;
+            sim->pointer = (sim->pointer + 1) % sim->frameCount;
+        }
+        frameIndex = sim->pointer;
+        pageIndexRemove(&sim->index, frames[frameIndex].pageNumber);
+        sim->pointer = (sim->pointer + 1) % sim->frameCount;
+    }
+    frames[frameIndex].pageNumber = page;
+    frames[frameIndex].useBit = 1;
+    pageIndexInsert(&sim->index, page, frameIndex);
+    return 1;
+}
+
+int clockHashSimEvict(ClockHashSim *sim) {
+    Frame *frames = sim->frames;
+    if (sim->freeCount == sim->frameCount) return -1;
+
+    // Same sweep as on a fault, stepping over frames that are already empty
+    while (frames[sim->pointer].pageNumber == -1 || frames[sim->pointer].useBit == 1) {
+        frames[sim->pointer].useBit = 0;
+        sim->pointer = (sim->pointer + 1) % sim->frameCount;
+    }
+    int frameIndex = sim->pointer;
+    int page = frames[frameIndex].pageNumber;
+    pageIndexRemove(&sim->index, page);
+    frames[frameIndex].pageNumber = -1;
+    sim->freeFrames[sim->freeCount++] = frameIndex;
+    sim->pointer = (sim->pointer + 1) % sim->frameCount;
+    return page;
+}
+
+int clockHashSimContains(const ClockHashSim *sim, int page) {
+    return pageIndexFind(&sim->index, page) != -1;
+}
+
+// Load a page nobody has asked for yet. Its use bit stays clear, so it is
+// the hand's first choice if it is still unused when the hand comes round.
+int clockHashSimPrefetch(ClockHashSim *sim, int page) {
+    if (!clockHashSimAccess(sim, page)) return 0;
+    sim->frames[pageIndexFind(&sim->index, page)].useBit = 0;
+    return 1;
+}
+
+void clockHashSimFree(ClockHashSim *sim) {
+    pageIndexFree(&sim->index);
+    free(sim->freeFrames);
+    free(sim->frames);
+    sim->frames = NULL;
+}
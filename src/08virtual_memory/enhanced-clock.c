@@ -0,0 +1,290 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Enhanced second-chance Clock (the Macintosh variant in Stallings). Every
+    frame has a use bit and a modified bit. A victim is found in up to four
+    sweeps of the hand:
+      1. Look for (use 0, modified 0) without changing any bits.
+      2. Look for (use 0, modified 1), clearing use bits on the way.
+      3 and 4. Repeat 1 and 2. Every use bit is clear by now, so one of them finds a frame.
+    A clean page costs nothing to drop. A dirty victim must be written back
+    before its frame can be reused, and the fault waits for that write. Faults
+    are charged readCost and dirty victims writeCost. The total is the I/O time
+    that the process actually stalls on.
+
+    The optional background cleaner runs every cleanInterval references. It
+    looks at cleanBatch frames ahead of the hand and writes back the dirty pages
+    whose use bit is clear, since those are the next likely victims. Those
+    writes happen off the fault path and are counted separately, so you can
+    see how much of the stall time they remove and how much extra I/O they add.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+int enhancedClockSimInit(EnhancedClockSim *sim, int frameCount, const WritebackConfig *config) {
+    memset(sim, 0, sizeof(*sim));
+    if (frameCount < 1 || config->cleanInterval < 0 || config->cleanBatch < 0) {
+        printf("Invalid enhanced Clock configuration\n");
+        return -1;
+    }
+    sim->frames = (Frame *)malloc(sizeof(Frame) * frameCount);
+    sim->freeFrames = (int *)malloc(sizeof(int) * frameCount);
+    if (sim->frames == NULL || sim->freeFrames == NULL || pageIndexInit(&sim->index, frameCount) < 0) {
+        free(sim->frames);
+        free(sim->freeFrames);
+        sim->frames = NULL;
+        return -1;
+    }
+    for (int i = 0; i < frameCount; i++) {
+        sim->frames[i].pageNumber = -1;
+        sim->frames[i].useBit = 0;
+        sim->frames[i].modifiedBit = 0;
+        sim->freeFrames[i] = frameCount - 1 - i;
+    }
+    sim->freeCount = frameCount;
+    sim->frameCount = frameCount;
+    sim->config = *config;
+    return 0;
+}
+
+static int findVictim(EnhancedClockSim *sim) {
+    Frame *frames = sim->frames;
+    int n = sim->frameCount;
+    int start = sim->pointer;
+
+    if (sim->config.plainClock) {
+        while (frames[sim->pointer].useBit == 1) {
+            frames[sim->pointer].useBit = 0;
+            sim->pointer = (sim->pointer + 1) % n;
+        }
+        return sim->pointer;
+    }
+
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0, k = start; i < n; i++, k = (k + 1) % n) {
+            if (!frames[k].useBit && !frames[k].modifiedBit) return k;
+        }
+        for (int i = 0, k = start; i < n; i++, k = (k + 1) % n) {
+            if (!frames[k].useBit) return k; // Modified, or step 1 would have taken it
+            frames[k].useBit = 0;
+        }
+    }
+    return start; // Not reached: the second round always finds a frame
+}
+
+// Write back dirty, unused pages just ahead of the hand
+static void runCleaner(EnhancedClockSim *sim) {
+    for (int i = 0, k = sim->pointer; i < sim->config.cleanBatch && i < sim->frameCount;
+         i++, k = (k + 1) % sim->frameCount) {
+        Frame *frame = &sim->frames[k];
+        if (frame->pageNumber != -1 && frame->modifiedBit && !frame->useBit) {
+            frame->modifiedBit = 0;
+            sim->cleanerWrites++;
+        }
+    }
+}
+
+int enhancedClockSimAccess(EnhancedClockSim *sim, int page, int isWrite) {
+    Frame *frames = sim->frames;
+    int fault = 0;
+    int frameIndex = pageIndexFind(&sim->index, page);
+
+    sim->references++;
+    sim->writes += isWrite != 0;
+
+    if (frameIndex == -1) {
+        fault = 1;
+        sim->faults++;
+        sim->stallTime += sim->config.readCost;
+
+        if (sim->freeCount > 0) {
+            frameIndex = sim->freeFrames[--sim->freeCount];
+        } else {
+            frameIndex = findVictim(sim);
+            if (frames[frameIndex].modifiedBit) {
+                sim->writebacks++;
+                sim->stallTime += sim->config.writeCost;
+            }
+            pageIndexRemove(&sim->index, frames[frameIndex].pageNumber);
+            sim->pointer = (frameIndex + 1) % sim->frameCount;
+        }
+        frames[frameIndex].pageNumber = page;
+        frames[frameIndex].modifiedBit = 0;
+        pageIndexInsert(&sim->index, page, frameIndex);
+    }
+    frames[frameIndex].useBit = 1;
+    if (isWrite) frames[frameIndex].modifiedBit = 1;
+
+    if (sim->config.cleanInterval > 0 && sim->references % sim->config.cleanInterval == 0) runCleaner(sim);
+    return fault;
+}
+
+void printWritebackStats(const EnhancedClockSim *sim, const char *label) {
+    long long cleanerTime = sim->cleanerWrites * sim->config.writeCost;
+    printf("%-18s %10lld %11lld %12lld %14lld %14lld\n", label, sim->faults, sim->writebacks,
+           sim->cleanerWrites, sim->stallTime, sim->stallTime + cleanerTime);
+}
+
+void enhancedClockSimFree(EnhancedClockSim *sim) {
+    pageIndexFree(&sim->index);
+    free(sim->freeFrames);
+    free(sim->frames);
+    sim->frames = NULL;
+}
+
+int loadReadWriteTrace(const char *path, int **pages, unsigned char **writes, long long *length) {
+    FILE *in = fopen(path, "r");
+    long long capacity = 4096;
+    long long count = 0;
+    char line[64];
+
+    if (in == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    *pages = (int *)malloc(sizeof(int) * capacity);
+    *writes = (unsigned char *)malloc(capacity);
+    if (*pages == NULL || *writes == NULL) goto fail;
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        char *text = line;
+        int isWrite = 0;
+        while (*text == ' ' || *text == '\t') text++;
+        if (*text == '\n' || *text == '\0' || *text == '#') continue;
+        if (*text == 'W' || *text == 'w' || *text == 'R' || *text == 'r') {
+            isWrite = *text == 'W' || *text == 'w';
+            text++;
+        }
+
+        char *end;
+        long page = strtol(text, &end, 10);
+        if (end == text || page < 0 || page > 0x7fffffffL) {
+            printf("Bad reference in %s: %s", path, line);
+            goto fail;
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            int *morePages = (int *)realloc(*pages, sizeof(int) * capacity);
+            if (morePages == NULL) goto fail;
+            *pages = morePages;
+            unsigned char *moreWrites = (unsigned char *)realloc(*writes, capacity);
+            if (moreWrites == NULL) goto fail;
+            *writes = moreWrites;
+        }
+        (*pages)[count] = (int)page;
+        (*writes)[count] = (unsigned char)isWrite;
+        count++;
+    }
+    fclose(in);
+    *length = count;
+    return 0;
+
+fail:
+    fclose(in);
+    free(*pages);
+    free(*writes);
+    *pages = NULL;
+    *writes = NULL;
+    return -1;
+}
+
+static int runWriteback(const int pages[], const unsigned char writes[], long long length, int frameCount,
+                        const WritebackConfig *config, const char *label) {
+    EnhancedClockSim sim;
+    if (enhancedClockSimInit(&sim, frameCount, config) < 0) return -1;
+    for (long long i = 0; i < length; i++) {
+        enhancedClockSimAccess(&sim, pages[i], writes[i]);
+    }
+    printWritebackStats(&sim, label);
+    enhancedClockSimFree(&sim);
+    return 0;
+}
+
+// Plain Clock, enhanced Clock, and enhanced Clock with the cleaner, on the same references
+static int compareWriteback(const int pages[], const unsigned char writes[], long long length, int frameCount,
+                            const WritebackConfig *config) {
+    WritebackConfig plain = *config;
+    WritebackConfig enhanced = *config;
+    WritebackConfig cleaned = *config;
+    plain.plainClock = 1;
+    plain.cleanInterval = 0;
+    enhanced.plainClock = 0;
+    enhanced.cleanInterval = 0;
+    cleaned.plainClock = 0;
+    if (cleaned.cleanInterval == 0) cleaned.cleanInterval = 64;
+    if (cleaned.cleanBatch == 0) cleaned.cleanBatch = 8;
+
+    printf("%-18s %10s %11s %12s %14s %14s\n", "Policy", "Faults", "Write-backs", "Cleaner", "Stall time",
+           "Total I/O");
+    if (runWriteback(pages, writes, length, frameCount, &plain, "Clock") < 0) return -1;
+    if (runWriteback(pages, writes, length, frameCount, &enhanced, "Enhanced Clock") < 0) return -1;
+    return runWriteback(pages, writes, length, frameCount, &cleaned, "Enhanced + cleaner");
+}
+
+int writebackTrace(const char *path, int frameCount, const WritebackConfig *config) {
+    int *pages;
+    unsigned char *writes;
+    long long length;
+
+    if (loadReadWriteTrace(path, &pages, &writes, &length) < 0) return -1;
+    printf("Trace %s: %lld references, %d frames\n", path, length, frameCount);
+    int result = compareWriteback(pages, writes, length, frameCount, config);
+    free(pages);
+    free(writes);
+    return result;
+}
+
+int enhancedClockDemo() {
+    int length = 1000000;
+    int *pages = (int *)malloc(sizeof(int) * length);
+    unsigned char *writes = (unsigned char *)malloc(length);
+    if (pages == NULL || writes == NULL) {
+        free(pages);
+        free(writes);
+        return -1;
+    }
+
+    // Pages 0-99 are read only; pages 100-199 are written half the time
+    for (int i = 0; i < length; i++) {
+        pages[i] = rand() % 200;
+        writes[i] = pages[i] >= 100 && rand() % 2 == 0;
+    }
+
+    // A disk read of 8 ms and a write of 10 ms, in units of 0.1 ms
+    WritebackConfig config = {80, 100, 32, 16, 0};
+    printf("Enhanced Clock on 200 pages, 120 frames, with I/O times in 0.1 ms:\n");
+    int result = compareWriteback(pages, writes, length, 120, &config);
+    free(pages);
+    free(writes);
+    return result;
+}
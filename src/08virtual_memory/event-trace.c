@@ -0,0 +1,249 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Output control for the paging demos. The classic demos printed the frames
+    after every reference, and at that rate formatting costs far more than
+    the algorithm itself. In SIM_OUTPUT_QUIET they only count faults. In
+    SIM_OUTPUT_TRACE each reference becomes a 16-byte PageEvent: page, evicted
+    page, resident set size and hit flag.
+
+    The events go into a single-producer, single-consumer ring with no lock.
+    The simulating thread owns the head and a background writer thread owns the
+    tail. Each side reads the other's index with acquire and publishes its own
+    with release, so the hot path takes no lock and makes no system call. The
+    writer hands whole contiguous runs of the ring to write(). When the ring is
+    full, the producer yields until there is room. Those waits are counted, so
+    a slow disk shows up as stalls and never as lost events.
+
+    The trace file is a plain array of PageEvent in native byte order, in the
+    same spirit as the raw page trace format.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <time.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+int simOutputMode = SIM_OUTPUT_VERBOSE;
+
+static struct {
+    PageEvent *events;
+    unsigned long long mask;
+    _Atomic unsigned long long head; // Next event to fill, written by the producer only
+    _Atomic unsigned long long tail; // Next event to write out, written by the writer only
+    unsigned long long cachedTail; // Producer's last look at tail
+    _Atomic int running;
+    pthread_t writer;
+    int fd;
+    int failed; // The writer hit a write error
+    int previousMode;
+    long long stalls;
+} ring;
+
+static int writeAll(int fd, const char *data, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t written = write(fd, data, bytes);
+        if (written < 0) return -1;
+        data += written;
+        bytes -= written;
+    }
+    return 0;
+}
+
+static void *eventWriter(void *arg) {
+    (void)arg;
+    unsigned long long tail = atomic_load_explicit(&ring.tail, memory_order_relaxed);
+
+    while (1) {
+        // Read running before head, so no event published before the stop is missed
+        int running = atomic_load_explicit(&ring.running, memory_order_acquire);
+        unsigned long long head = atomic_load_explicit(&ring.head, memory_order_acquire);
+
+        if (head == tail) {
+            if (!running) break;
+            struct timespec pause = {0, 50000};
+            nanosleep(&pause, NULL);
+            continue;
+        }
+
+        // Write up to the end of the ring; the rest goes in the next round
+        unsigned long long start = tail & ring.mask;
+        unsigned long long count = head - tail;
+        if (count > ring.mask + 1 - start) count = ring.mask + 1 - start;
+        if (!ring.failed && writeAll(ring.fd, (const char *)(ring.events + start), count * sizeof(PageEvent)) < 0) {
+            perror("write");
+            ring.failed = 1; // Keep draining so the producer never blocks for good
+        }
+        tail += count;
+        atomic_store_explicit(&ring.tail, tail, memory_order_release);
+    }
+    return NULL;
+}
+
+int startEventTrace(const char *outPath, int capacity) {
+    if (ring.events != NULL) {
+        printf("An event trace is already running\n");
+        return -1;
+    }
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        printf("The event ring capacity must be a power of two\n");
+        return -1;
+    }
+
+    ring.fd = open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (ring.fd < 0) {
+        perror("open");
+        return -1;
+    }
+    ring.events = (PageEvent *)malloc(sizeof(PageEvent) * capacity);
+    if (ring.events == NULL) {
+        close(ring.fd);
+        return -1;
+    }
+    ring.mask = capacity - 1;
+    atomic_store(&ring.head, 0);
+    atomic_store(&ring.tail, 0);
+    ring.cachedTail = 0;
+    ring.failed = 0;
+    ring.stalls = 0;
+    atomic_store(&ring.running, 1);
+
+    if (pthread_create(&ring.writer, NULL, eventWriter, NULL) != 0) {
+        printf("Could not start the event writer\n");
+        free(ring.events);
+        ring.events = NULL;
+        close(ring.fd);
+        return -1;
+    }
+    ring.previousMode = simOutputMode;
+    simOutputMode = SIM_OUTPUT_TRACE;
+    return 0;
+}
+
+void emitPageEvent(int page, int hit, int evicted, int resident) {
+    unsigned long long head = atomic_load_explicit(&ring.head, memory_order_relaxed);
+
+    if (ring.events == NULL) return;
+    if (head - ring.cachedTail > ring.mask) {
+        ring.cachedTail = atomic_load_explicit(&ring.tail, memory_order_acquire);
+        while (head - ring.cachedTail > ring.mask) {
+            ring.stalls++;
+            sched_yield();
+            ring.cachedTail = atomic_load_explicit(&ring.tail, memory_order_acquire);
+        }
+    }
+
+    PageEvent *event = &ring.events[head & ring.mask];
+    event->page = page;
+    event->evicted = evicted;
+    event->resident = resident;
+    event->hit = hit;
+    atomic_store_explicit(&ring.head, head + 1, memory_order_release);
+}
+
+long long stopEventTrace() {
+    if (ring.events == NULL) return -1;
+
+    atomic_store_explicit(&ring.running, 0, memory_order_release);
+    pthread_join(ring.writer, NULL);
+    long long written = (long long)atomic_load(&ring.tail);
+    int failed = ring.failed;
+
+    if (close(ring.fd) < 0) {
+        perror("close");
+        failed = 1;
+    }
+    free(ring.events);
+    ring.events = NULL;
+    simOutputMode = ring.previousMode;
+    if (ring.stalls > 0) printf("Event trace: the simulator waited %lld times for the writer\n", ring.stalls);
+    return failed ? -1 : written;
+}
+
+static double secondsSince(struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int eventTraceDemo() {
+    const char *path = "event-trace-demo.bin";
+    int pages[12] = {2, 3, 2, 1, 5, 2, 4, 5, 3, 2, 5, 2};
+    int frames[4];
+    Frame clockFrames[4];
+    long long runs = 10000000; // 120 million references
+    long long faults = 0;
+    struct timespec start;
+
+    simOutputMode = SIM_OUTPUT_QUIET;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long long r = 0; r < runs; r++) faults += fifo(pages, frames);
+    double quiet = secondsSince(&start);
+    printf("Quiet FIFO: %lld references, %lld faults, %.1f million references per second\n",
+           runs * 12, faults, runs * 12 / quiet / 1e6);
+
+    faults = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long long r = 0; r < runs; r++) faults += clockPageReplacement(pages, clockFrames);
+    printf("Quiet Clock: %lld faults, %.1f million references per second\n", faults, runs * 12 / secondsSince(&start) / 1e6);
+
+    // Same work with every reference sent to the writer thread
+    runs /= 10;
+    if (startEventTrace(path, 1 << 16) < 0) return -1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long long r = 0; r < runs; r++) fifo(pages, frames);
+    long long written = stopEventTrace();
+    double traced = secondsSince(&start);
+    simOutputMode = SIM_OUTPUT_VERBOSE;
+    if (written < 0) {
+        remove(path);
+        return -1;
+    }
+    printf("Traced FIFO: %lld events written in %.3fs, %.1f million events per second\n",
+           written, traced, written / traced / 1e6);
+
+    // Read back the first run
+    FILE *in = fopen(path, "rb");
+    if (in != NULL) {
+        PageEvent event;
+        printf("%6s %6s %8s %8s\n", "Page", "Hit", "Evicted", "Resident");
+        for (int i = 0; i < 12 && fread(&event, sizeof(event), 1, in) == 1; i++) {
+            printf("%6d %6d %8d %8d\n", event.page, event.hit, event.evicted, event.resident);
+        }
+        fclose(in);
+    }
+    remove(path);
+    return 0;
+}
@@ -31,19 +31,17 @@
     SOFTWARE.
 */
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
+#include "page-policy.h"
+#include "page-trace.h"
 
 #define PAGE_SEQ_LEN 12
 #define NUMBER_OF_FRAMES 4
 
 // Function to check if a page is already in a frame
 bool isPageInFrames(int page, int frames[]) {
-    for (int i = 0; i < NUMBER_OF_FRAMES; i++) {
-        if (frames[i] == page) {
-            return true;
-        }
-    }
-    return false;
+    return findPageSimd(frames, NUMBER_OF_FRAMES, page) != -1;
 }
 
 void printFramesFifo(int frames[]) {
@@ -71,9 +69,13 @@ int fifo(int pages[], int frames[]) {
     for (int i = 0; i < PAGE_SEQ_LEN; i++) {
         int currentPage = pages[i];
 
+        int hit = isPageInFrames(currentPage, frames);
+        int evicted = -1;
+
         // If the current page is not in frames, we have a page fault
-        if (!isPageInFrames(currentPage, frames)) {
+        if (!hit) {
             // Replace the oldest page with the current page
+            evicted = frames[pageInsertIndex];
             frames[pageInsertIndex] = currentPage;
 
             // Move to the next frame index, wrapping around if necessary
@@ -82,8 +84,12 @@ int fifo(int pages[], int frames[]) {
             // Increase the count of page faults
             pageFaults++;
         }
-        printf("Processing page %d: ", currentPage);
-        printFramesFifo(frames);
+        if (simOutputMode == SIM_OUTPUT_VERBOSE) {
+            printf("Processing page %d: ", currentPage);
+            printFramesFifo(frames);
+        } else if (simOutputMode == SIM_OUTPUT_TRACE) {
+            emitPageEvent(currentPage, hit, evicted, pageFaults < NUMBER_OF_FRAMES ? pageFaults : NUMBER_OF_FRAMES);
+        }
     }
 
     return pageFaults;
@@ -97,4 +103,49 @@ int FIFODemo() {
 
     printf("Total Page Faults: %d\n", pageFaults);
     return 0;
-}
\ No newline at end of file
+}
+
+// Step-by-step FIFO with a run-time frame count, used by the trace replay engine
+int fifoSimInit(FifoSim *sim, int frameCount) {
+    sim->frames = (int *)malloc(sizeof(int) * frameCount);
+    if (sim->frames == NULL) return -1;
+    for (int i = 0; i < frameCount; i++) {
+        sim->frames[i] = -1;
+    }
+    sim->frameCount = frameCount;
+    sim->insertIndex = 0;
+    return 0;
+}
+
+int fifoSimAccess(FifoSim *sim, int page) {
+    if (findPageSimd(sim->frames, sim->frameCount, page) != -1) {
+        return 0; // Hit
+    }
+    // Replace the oldest page with the current page
+    sim->frames[sim->insertIndex] = page;
+    sim->insertIndex = (sim->insertIndex + 1) % sim->frameCount;
+    return 1;
+}
+
+// Empty frames always form one run starting at insertIndex, so the oldest
+// page is the first one found from there
+int fifoSimEvict(FifoSim *sim) {
+    for (int n = 0; n < sim->frameCount; n++) {
+        int i = (sim->insertIndex + n) % sim->frameCount;
+        if (sim->frames[i] != -1) {
+            int page = sim->frames[i];
+            sim->frames[i] = -1;
+            return page;
+        }
+    }
+    return -1;
+}
+
+int fifoSimContains(const FifoSim *sim, int page) {
+    return findPageSimd(sim->frames, sim->frameCount, page) != -1;
+}
+
+void fifoSimFree(FifoSim *sim) {
+    free(sim->frames);
+    sim->frames = NULL;
+}
@@ -0,0 +1,378 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Many processes sharing one pool of physical frames. Each process has its
+    own trace. The scheduler runs them round robin, a quantum of references at a
+    time, so their references interleave the way they would on one CPU.
+
+    Global replacement takes the victim from the whole pool, with a clock or an
+    LRU list over every frame. Each frame records its owner, and each process has
+    a page index to its frames, so a hit, a fault and an eviction are all O(1).
+    Local replacement leaves the sizing to each process. Under PFF, a fault that
+    comes more than pffThreshold references after the previous one releases
+    every page not used since that fault. Under VSWS, a sample after L
+    references, or after Q faults once M references have passed, releases every
+    page not used since the last sample. Both keep the resident set in the
+    working-set engine, so releasing pages never scans. A process that needs a
+    frame when the pool is empty replaces its own oldest page. If it has none,
+    the steal hand takes a frame from the next process that has one.
+
+    Throughput counts a reference as 1 time unit and a fault as faultCost.
+    Fairness is Jain's index over each process's rate of progress,
+    references / (references + faults * faultCost). It is 1 when every process
+    progresses at the same rate.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "frame-pool-sim.h"
+
+int framePoolSimInit(FramePoolSim *sim, const FramePoolConfig *config,
+                     const int *const traces[], const long long lengths[], int processCount) {
+    sim->processes = NULL;
+    sim->frames = NULL;
+    sim->freeFrames = NULL;
+    sim->runQueue = NULL;
+    sim->processCount = 0;
+
+    if (config->policy < POOL_GLOBAL_CLOCK || config->policy > POOL_LOCAL_VSWS || config->poolFrames < 1 ||
+        config->quantum < 1 || processCount < 1) {
+        printf("Invalid frame pool configuration\n");
+        return -1;
+    }
+    if (config->policy == POOL_LOCAL_VSWS && config->L < 1) {
+        printf("VSWS needs L >= 1\n");
+        return -1;
+    }
+    sim->config = *config;
+    sim->references = 0;
+    sim->faults = 0;
+    sim->steals = 0;
+    sim->residentTotal = 0;
+    sim->stealHand = 0;
+    sim->hand = 0;
+    sim->lruHead = -1;
+    sim->lruTail = -1;
+
+    int global = config->policy <= POOL_GLOBAL_LRU;
+    sim->processes = (PoolProcess *)calloc(processCount, sizeof(PoolProcess));
+    sim->runQueue = (int *)malloc(sizeof(int) * processCount);
+    if (global) {
+        sim->frames = (PoolFrame *)malloc(sizeof(PoolFrame) * config->poolFrames);
+        sim->freeFrames = (int *)malloc(sizeof(int) * config->poolFrames);
+    }
+    if (sim->processes == NULL || sim->runQueue == NULL ||
+        (global && (sim->frames == NULL || sim->freeFrames == NULL))) {
+        framePoolSimFree(sim);
+        return -1;
+    }
+
+    for (int f = 0; f < (global ? config->poolFrames : 0); f++) {
+        sim->frames[f].owner = -1;
+        sim->frames[f].useBit = 0;
+        sim->freeFrames[f] = config->poolFrames - 1 - f; // Hand out frame 0 first
+    }
+    sim->freeCount = global ? config->poolFrames : 0;
+
+    for (int p = 0; p < processCount; p++) {
+        PoolProcess *process = &sim->processes[p];
+        process->pages = traces[p];
+        process->length = lengths[p];
+        int result = global ? pageIndexInit(&process->index, 16) : workingSetInit(&process->ws, 16, 0);
+        if (result < 0) {
+            framePoolSimFree(sim);
+            return -1;
+        }
+        sim->processCount++;
+        sim->runQueue[p] = p;
+    }
+    sim->runCount = processCount;
+    return 0;
+}
+
+static void lruUnlink(FramePoolSim *sim, int f) {
+    PoolFrame *frame = &sim->frames[f];
+    if (frame->prev != -1) sim->frames[frame->prev].next = frame->next;
+    else sim->lruHead = frame->next;
+    if (frame->next != -1) sim->frames[frame->next].prev = frame->prev;
+    else sim->lruTail = frame->prev;
+}
+
+static void lruPushHead(FramePoolSim *sim, int f) {
+    sim->frames[f].prev = -1;
+    sim->frames[f].next = sim->lruHead;
+    if (sim->lruHead != -1) sim->frames[sim->lruHead].prev = f;
+    sim->lruHead = f;
+    if (sim->lruTail == -1) sim->lruTail = f;
+}
+
+// Pick a frame to reuse from the whole pool for process pid and take it from its owner
+static int globalVictim(FramePoolSim *sim, int pid) {
+    int f;
+    if (sim->config.policy == POOL_GLOBAL_LRU) {
+        f = sim->lruTail;
+        lruUnlink(sim, f);
+    } else {
+        while (sim->frames[sim->hand].useBit) {
+            sim->frames[sim->hand].useBit = 0;
+            sim->hand = (sim->hand + 1) % sim->config.poolFrames;
+        }
+        f = sim->hand;
+        sim->hand = (sim->hand + 1) % sim->config.poolFrames;
+    }
+    PoolProcess *owner = &sim->processes[sim->frames[f].owner];
+    pageIndexRemove(&owner->index, sim->frames[f].page);
+    owner->resident--;
+    if (sim->frames[f].owner != pid) {
+        owner->stolen++;
+        sim->steals++;
+    }
+    return f;
+}
+
+static int globalAccess(FramePoolSim *sim, int pid, int page) {
+    PoolProcess *process = &sim->processes[pid];
+    int f = pageIndexFind(&process->index, page);
+
+    if (f != -1) {
+        if (sim->config.policy == POOL_GLOBAL_LRU) {
+            lruUnlink(sim, f);
+            lruPushHead(sim, f);
+        } else {
+            sim->frames[f].useBit = 1;
+        }
+        return 0;
+    }
+
+    if (pageIndexReserve(&process->index, process->index.count + 1) < 0) return -1;
+    f = sim->freeCount > 0 ? sim->freeFrames[--sim->freeCount] : globalVictim(sim, pid);
+    sim->frames[f].owner = pid;
+    sim->frames[f].page = page;
+    sim->frames[f].useBit = 1;
+    if (sim->config.policy == POOL_GLOBAL_LRU) lruPushHead(sim, f);
+    pageIndexInsert(&process->index, page, f);
+    process->resident++;
+    return 1;
+}
+
+// Take the oldest page of the next process that has any, for a process with no frames at all
+static void stealFrame(FramePoolSim *sim, int pid) {
+    while (sim->stealHand == pid || sim->processes[sim->stealHand].ws.size == 0) {
+        sim->stealHand = (sim->stealHand + 1) % sim->processCount;
+    }
+    PoolProcess *victim = &sim->processes[sim->stealHand];
+    workingSetEvictOldest(&victim->ws);
+    victim->resident--;
+    victim->stolen++;
+    sim->residentTotal--;
+    sim->steals++;
+    sim->stealHand = (sim->stealHand + 1) % sim->processCount;
+}
+
+static int localAccess(FramePoolSim *sim, int pid, int page) {
+    const FramePoolConfig *config = &sim->config;
+    PoolProcess *process = &sim->processes[pid];
+    WorkingSet *ws = &process->ws;
+    int fault = !workingSetContains(ws, page);
+
+    if (fault) {
+        // PFF: a long gap since the last fault means the locality changed
+        if (config->policy == POOL_LOCAL_PFF && ws->now - process->lastFault > config->pffThreshold) {
+            sim->residentTotal -= workingSetTrim(ws, process->lastFault);
+        }
+        process->lastFault = ws->now;
+        process->intervalFaults++;
+
+        if (sim->residentTotal == config->poolFrames) {
+            if (ws->size > 0) {
+                workingSetEvictOldest(ws);
+                sim->residentTotal--;
+            } else {
+                stealFrame(sim, pid);
+            }
+        }
+    }
+
+    int before = ws->size;
+    if (workingSetAccess(ws, page) < 0) return -1;
+    sim->residentTotal += ws->size - before;
+
+    if (config->policy == POOL_LOCAL_VSWS) {
+        long long elapsed = ws->now - process->lastSample;
+        if (elapsed >= config->L || (process->intervalFaults >= config->Q && elapsed >= config->M)) {
+            sim->residentTotal -= workingSetTrim(ws, process->lastSample);
+            process->lastSample = ws->now;
+            process->intervalFaults = 0;
+        }
+    }
+    process->resident = ws->size;
+    return fault;
+}
+
+int framePoolRun(FramePoolSim *sim) {
+    int global = sim->config.policy <= POOL_GLOBAL_LRU;
+    int turn = 0;
+
+    while (sim->runCount > 0) {
+        if (turn >= sim->runCount) turn = 0;
+        int pid = sim->runQueue[turn];
+        PoolProcess *process = &sim->processes[pid];
+
+        long long end = process->position + sim->config.quantum;
+        if (end > process->length) end = process->length;
+        for (; process->position < end; process->position++) {
+            int page = process->pages[process->position];
+            int fault = global ? globalAccess(sim, pid, page) : localAccess(sim, pid, page);
+            if (fault < 0) {
+                printf("Out of memory while running process %d\n", pid);
+                return -1;
+            }
+            process->faults += fault;
+            process->residentSum += process->resident;
+            sim->faults += fault;
+            sim->references++;
+        }
+
+        if (process->position == process->length) {
+            sim->runQueue[turn] = sim->runQueue[--sim->runCount]; // The last one runs next
+        } else {
+            turn++;
+        }
+    }
+    return 0;
+}
+
+void printFramePoolStats(const FramePoolSim *sim, const char *label) {
+    const char *names[] = {"global clock", "global LRU", "local PFF", "local VSWS"};
+    double cost = sim->config.faultCost;
+    double rateSum = 0, rateSquares = 0;
+    double worst = 1, best = 0;
+
+    printf("%s: %s, %d processes, %d frames\n", label, names[sim->config.policy], sim->processCount,
+           sim->config.poolFrames);
+    if (sim->processCount <= 16) {
+        printf("%8s %12s %10s %12s %10s\n", "Process", "References", "Fault rate", "Avg frames", "Stolen");
+    }
+    for (int p = 0; p < sim->processCount; p++) {
+        const PoolProcess *process = &sim->processes[p];
+        double progress = process->length > 0 ? process->length / (process->length + process->faults * cost) : 1;
+        rateSum += progress;
+        rateSquares += progress * progress;
+        if (progress < worst) worst = progress;
+        if (progress > best) best = progress;
+        if (sim->processCount <= 16) {
+            printf("%8d %12lld %10.4f %12.2f %10lld\n", p, process->length,
+                   process->length > 0 ? (double)process->faults / process->length : 0.0,
+                   process->length > 0 ? (double)process->residentSum / process->length : 0.0, process->stolen);
+        }
+    }
+
+    double time = sim->references + sim->faults * cost;
+    printf("  faults %lld of %lld references (%.4f), steals %lld\n", sim->faults, sim->references,
+           sim->references > 0 ? (double)sim->faults / sim->references : 0.0, sim->steals);
+    printf("  throughput %.4f references per time unit, fairness %.4f (slowest %.4f, fastest %.4f)\n",
+           time > 0 ? sim->references / time : 0.0,
+           rateSquares > 0 ? rateSum * rateSum / (sim->processCount * rateSquares) : 1.0, worst, best);
+}
+
+void framePoolSimFree(FramePoolSim *sim) {
+    int global = sim->config.policy <= POOL_GLOBAL_LRU;
+    for (int p = 0; p < sim->processCount; p++) {
+        if (global) pageIndexFree(&sim->processes[p].index);
+        else workingSetFree(&sim->processes[p].ws);
+    }
+    free(sim->processes);
+    free(sim->frames);
+    free(sim->freeFrames);
+    free(sim->runQueue);
+    sim->processes = NULL;
+    sim->frames = NULL;
+    sim->freeFrames = NULL;
+    sim->runQueue = NULL;
+    sim->processCount = 0;
+}
+
+// Phases of locality: each phase uses its own set of pages, of a size picked per process
+static void makeProcessTrace(int pages[], long long length, int localityPages) {
+    int base = 0;
+    for (long long i = 0; i < length; i++) {
+        if (i % 2000 == 0) base = rand() % 1000 * localityPages;
+        pages[i] = base + rand() % localityPages;
+    }
+}
+
+static int runPoolCase(int processCount, long long length, int poolFrames, int quantum) {
+    int **traces = (int **)calloc(processCount, sizeof(int *));
+    long long *lengths = (long long *)malloc(sizeof(long long) * processCount);
+    int result = 0;
+
+    if (traces == NULL || lengths == NULL) result = -1;
+    for (int p = 0; p < processCount && result == 0; p++) {
+        traces[p] = (int *)malloc(sizeof(int) * length);
+        if (traces[p] == NULL) {
+            result = -1;
+            break;
+        }
+        lengths[p] = length;
+        makeProcessTrace(traces[p], length, 5 + rand() % 40);
+    }
+
+    for (int policy = POOL_GLOBAL_CLOCK; policy <= POOL_LOCAL_VSWS && result == 0; policy++) {
+        FramePoolConfig config = {policy, poolFrames, quantum, 100, 20, 10, 40, 10};
+        FramePoolSim sim;
+        struct timespec t0, t1;
+
+        if (framePoolSimInit(&sim, &config, (const int *const *)traces, lengths, processCount) < 0) {
+            result = -1;
+            break;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        result = framePoolRun(&sim);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (result == 0) {
+            printFramePoolStats(&sim, "Frame pool");
+            double seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+            printf("  simulated at %.1f million references per second\n", sim.references / seconds / 1e6);
+        }
+        framePoolSimFree(&sim);
+    }
+
+    for (int p = 0; p < processCount && traces != NULL; p++) free(traces[p]);
+    free(traces);
+    free(lengths);
+    return result;
+}
+
+int framePoolDemo() {
+    printf("Four processes, 60 frames:\n");
+    if (runPoolCase(4, 20000, 60, 50) < 0) return -1;
+    printf("\n2000 processes, 40000 frames:\n");
+    return runPoolCase(2000, 10000, 40000, 100);
+}
@@ -0,0 +1,498 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Mixed page-size simulator. translation.c runs a whole trace with one page
+    size; real kernels map most memory with 4 KiB pages and back some 2 MiB
+    regions with one huge page (transparent huge pages, THP). This simulator
+    takes virtual addresses and lets a region change size while the trace runs:
+        - THP_NEVER maps everything with 4 KiB pages,
+        - THP_ALWAYS maps a whole 2 MiB page on the first fault in an empty
+          region, like THP "always" on a fault,
+        - THP_PROMOTE starts with 4 KiB pages and collapses a region into one
+          huge page once promoteThreshold of its 512 pages are resident, like
+          khugepaged (whose max_ptes_none = 511 default is promoteThreshold 1).
+    Pages of both sizes sit on one Clock. A huge victim that few of its 4 KiB
+    pages were touched in is demoted: it is split, the touched pages stay
+    resident and the rest of the 2 MiB is freed. Otherwise it is evicted whole.
+    There is one set-associative TLB per page size, as on x86 cores, and the
+    statistics report faults, resident memory, memory lost to untouched parts
+    of huge pages (bloat), and TLB hit rate and reach.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "translation-sim.h"
+
+#define BITMAP_WORDS (SUBPAGES / 64)
+#define ADDRESS_MASK ((1ull << 48) - 1) // x86-64 virtual addresses
+
+static int testBit(const unsigned long long *bits, int i) {
+    return (int)(bits[i >> 6] >> (i & 63) & 1);
+}
+
+static void setBit(unsigned long long *bits, int i) {
+    bits[i >> 6] |= 1ull << (i & 63);
+}
+
+static void clearBit(unsigned long long *bits, int i) {
+    bits[i >> 6] &= ~(1ull << (i & 63));
+}
+
+static int countBits(const unsigned long long *bits) {
+    int count = 0;
+    for (int w = 0; w < BITMAP_WORDS; w++) count += __builtin_popcountll(bits[w]);
+    return count;
+}
+
+// Set-associative TLB with LRU replacement, as in translateAddress
+static int tlbLookup(TlbEntry *tlb, int entries, int ways, unsigned long long key, long long time) {
+    TlbEntry *set = &tlb[(key & (unsigned long long)(entries / ways - 1)) * ways];
+    for (int w = 0; w < ways; w++) {
+        if (set[w].valid && set[w].vpn == key) {
+            set[w].stamp = time;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void tlbFill(TlbEntry *tlb, int entries, int ways, unsigned long long key, long long time) {
+    TlbEntry *set = &tlb[(key & (unsigned long long)(entries / ways - 1)) * ways];
+    int victim = 0;
+    for (int w = 0; w < ways; w++) {
+        if (!set[w].valid) {
+            victim = w;
+            break;
+        }
+        if (set[w].stamp < set[victim].stamp) victim = w;
+    }
+    set[victim].vpn = key;
+    set[victim].valid = 1;
+    set[victim].stamp = time;
+}
+
+static void tlbInvalidate(TlbEntry *tlb, int entries, int ways, unsigned long long key) {
+    TlbEntry *set = &tlb[(key & (unsigned long long)(entries / ways - 1)) * ways];
+    for (int w = 0; w < ways; w++) {
+        if (set[w].valid && set[w].vpn == key) set[w].valid = 0;
+    }
+}
+
+// Node the clock hand reaches last, i.e. just behind the hand
+static int insertNode(HugePageSim *sim, int region, int sub) {
+    if (sim->freeNode == -1) {
+        int capacity = sim->nodeCapacity * 2;
+        HugeClockNode *nodes = (HugeClockNode *)realloc(sim->nodes, sizeof(HugeClockNode) * capacity);
+        if (nodes == NULL) return -1;
+        for (int i = sim->nodeCapacity; i < capacity; i++) nodes[i].next = i + 1 < capacity ? i + 1 : -1;
+        sim->nodes = nodes;
+        sim->freeNode = sim->nodeCapacity;
+        sim->nodeCapacity = capacity;
+    }
+
+    int node = sim->freeNode;
+    HugeClockNode *n = &sim->nodes[node];
+    sim->freeNode = n->next;
+    n->region = region;
+    n->sub = sub;
+    n->useBit = 0;
+    if (sim->hand == -1) {
+        n->prev = n->next = node;
+        sim->hand = node;
+    } else {
+        n->next = sim->hand;
+        n->prev = sim->nodes[sim->hand].prev;
+        sim->nodes[n->prev].next = node;
+        sim->nodes[sim->hand].prev = node;
+    }
+    return node;
+}
+
+static void removeNode(HugePageSim *sim, int node) {
+    HugeClockNode *n = &sim->nodes[node];
+    if (n->next == node) {
+        sim->hand = -1;
+    } else {
+        if (sim->hand == node) sim->hand = n->next;
+        sim->nodes[n->prev].next = n->next;
+        sim->nodes[n->next].prev = n->prev;
+    }
+    n->next = sim->freeNode;
+    sim->freeNode = node;
+}
+
+static int findOrAddRegion(HugePageSim *sim, int number) {
+    int r = pageIndexFind(&sim->regionIndex, number);
+    if (r != -1) return r;
+
+    if (sim->regionCount == sim->regionCapacity) {
+        int capacity = sim->regionCapacity * 2;
+        HugeRegion *regions = (HugeRegion *)realloc(sim->regions, sizeof(HugeRegion) * capacity);
+        if (regions == NULL) return -1;
+        sim->regions = regions;
+        sim->regionCapacity = capacity;
+    }
+    if (pageIndexReserve(&sim->regionIndex, sim->regionCount + 1) < 0) return -1;
+
+    r = sim->regionCount++;
+    memset(&sim->regions[r], 0, sizeof(HugeRegion));
+    sim->regions[r].number = number;
+    sim->regions[r].hugeNode = -1;
+    pageIndexInsert(&sim->regionIndex, number, r);
+    return r;
+}
+
+static void unmapSubpage(HugePageSim *sim, int r, int sub) {
+    HugeRegion *region = &sim->regions[r];
+    unsigned long long vpn = (unsigned long long)region->number * SUBPAGES + sub;
+
+    removeNode(sim, region->subNodes[sub]);
+    clearBit(region->resident, sub);
+    region->residentCount--;
+    sim->freeFrames++;
+    tlbInvalidate(sim->tlb4K, sim->config.tlbEntries4K, sim->config.tlbWays, vpn);
+}
+
+static int mapSubpage(HugePageSim *sim, int r, int sub) {
+    HugeRegion *region = &sim->regions[r];
+    if (region->subNodes == NULL) {
+        region->subNodes = (int *)malloc(sizeof(int) * SUBPAGES);
+        if (region->subNodes == NULL) return -1;
+    }
+    int node = insertNode(sim, r, sub);
+    if (node < 0) return -1;
+    region->subNodes[sub] = node;
+    setBit(region->resident, sub);
+    region->residentCount++;
+    sim->freeFrames--;
+    return 0;
+}
+
+// Clock victim of a huge page: split it if most of it was never touched, otherwise evict it whole
+static int reclaimHugePage(HugePageSim *sim, int r) {
+    HugeRegion *region = &sim->regions[r];
+    int touched = countBits(region->touched);
+
+    tlbInvalidate(sim->tlb2M, sim->config.tlbEntries2M, sim->config.tlbWays, (unsigned long long)region->number);
+    region->huge = 0;
+    if (touched > 0 && touched < sim->config.demoteThreshold) {
+        // The split pages go behind the hand before the huge node leaves the clock
+        for (int sub = 0; sub < SUBPAGES; sub++) {
+            if (testBit(region->touched, sub) && mapSubpage(sim, r, sub) < 0) return -1;
+        }
+        sim->freeFrames += SUBPAGES;
+        sim->demotions++;
+    } else {
+        sim->freeFrames += SUBPAGES;
+        sim->hugeEvictions++;
+    }
+    removeNode(sim, region->hugeNode);
+    region->hugeNode = -1;
+    memset(region->touched, 0, sizeof(region->touched));
+    return 0;
+}
+
+// Run the clock until needed frames are free, leaving the pages of region protect alone
+static int reclaimFrames(HugePageSim *sim, long long needed, int protect) {
+    while (sim->freeFrames < needed) {
+        HugeClockNode *n = &sim->nodes[sim->hand];
+        if (n->region == protect || n->useBit == 1) {
+            n->useBit = 0;
+            sim->hand = n->next;
+        } else if (n->sub == -1) {
+            if (reclaimHugePage(sim, n->region) < 0) return -1;
+        } else {
+            unmapSubpage(sim, n->region, n->sub);
+        }
+    }
+    return 0;
+}
+
+static int mapHugePage(HugePageSim *sim, int r) {
+    int node = insertNode(sim, r, -1);
+    if (node < 0) return -1;
+    sim->regions[r].huge = 1;
+    sim->regions[r].hugeNode = node;
+    sim->freeFrames -= SUBPAGES;
+    return 0;
+}
+
+// Collapse a region's 4 KiB pages into one huge page, filling in the missing ones
+static int promoteRegion(HugePageSim *sim, int r) {
+    if (reclaimFrames(sim, SUBPAGES - sim->regions[r].residentCount, r) < 0) return -1;
+
+    HugeRegion *region = &sim->regions[r];
+    for (int sub = 0; sub < SUBPAGES; sub++) {
+        if (testBit(region->resident, sub)) unmapSubpage(sim, r, sub);
+    }
+    // One pass over the 4 KiB TLB is cheaper than one invalidation per page
+    for (int e = 0; e < sim->config.tlbEntries4K; e++) {
+        if (sim->tlb4K[e].valid && sim->tlb4K[e].vpn / SUBPAGES == (unsigned long long)region->number) {
+            sim->tlb4K[e].valid = 0;
+        }
+    }
+    sim->promotions++;
+    return mapHugePage(sim, r);
+}
+
+int hugePageSimInit(HugePageSim *sim, const HugePageConfig *config) {
+    int ways = config->tlbWays;
+
+    memset(sim, 0, sizeof(*sim));
+    if (config->thpMode < THP_NEVER || config->thpMode > THP_PROMOTE || config->promoteThreshold < 1 ||
+        config->promoteThreshold > SUBPAGES || config->memoryBytes < 4096 || config->memoryBytes % 4096 != 0 ||
+        ways < 1 || config->tlbEntries4K < ways || config->tlbEntries2M < ways ||
+        config->tlbEntries4K % ways != 0 || config->tlbEntries2M % ways != 0 ||
+        ((config->tlbEntries4K / ways) & (config->tlbEntries4K / ways - 1)) != 0 ||
+        ((config->tlbEntries2M / ways) & (config->tlbEntries2M / ways - 1)) != 0) {
+        printf("Invalid huge page configuration\n");
+        return -1;
+    }
+    sim->config = *config;
+    sim->totalFrames = sim->freeFrames = config->memoryBytes / 4096;
+    sim->hand = -1;
+    sim->regionCapacity = 64;
+    sim->nodeCapacity = 1024;
+
+    sim->regions = (HugeRegion *)malloc(sizeof(HugeRegion) * sim->regionCapacity);
+    sim->nodes = (HugeClockNode *)malloc(sizeof(HugeClockNode) * sim->nodeCapacity);
+    sim->tlb4K = (TlbEntry *)calloc(config->tlbEntries4K, sizeof(TlbEntry));
+    sim->tlb2M = (TlbEntry *)calloc(config->tlbEntries2M, sizeof(TlbEntry));
+    if (sim->regions == NULL || sim->nodes == NULL || sim->tlb4K == NULL || sim->tlb2M == NULL ||
+        pageIndexInit(&sim->regionIndex, sim->regionCapacity) < 0) {
+        printf("Out of memory for the huge page simulator\n");
+        hugePageSimFree(sim);
+        return -1;
+    }
+    for (int i = 0; i < sim->nodeCapacity; i++) sim->nodes[i].next = i + 1 < sim->nodeCapacity ? i + 1 : -1;
+    return 0;
+}
+
+int hugePageAccess(HugePageSim *sim, unsigned long long address) {
+    unsigned long long vpn = (address & ADDRESS_MASK) >> 12;
+    int number = (int)(vpn / SUBPAGES);
+    int sub = (int)(vpn % SUBPAGES);
+    int fault = 0;
+    int r = findOrAddRegion(sim, number);
+
+    if (r < 0) {
+        printf("Out of memory for the huge page simulator\n");
+        return -1;
+    }
+    sim->references++;
+    sim->time++;
+
+    // Both TLBs are probed together; only the one for the region's current page size can hit
+    int huge = sim->regions[r].huge;
+    int tlbHit = huge ? tlbLookup(sim->tlb2M, sim->config.tlbEntries2M, sim->config.tlbWays, (unsigned long long)number, sim->time)
+                      : tlbLookup(sim->tlb4K, sim->config.tlbEntries4K, sim->config.tlbWays, vpn, sim->time);
+    if (tlbHit) {
+        sim->tlbHits++;
+    } else {
+        sim->walkReferences += huge ? 3 : 4; // A 2 MiB mapping ends the 4-level walk one level early
+    }
+
+    if (!huge && !testBit(sim->regions[r].resident, sub)) {
+        fault = 1;
+        int status;
+        if (sim->config.thpMode == THP_ALWAYS && sim->regions[r].residentCount == 0 && sim->totalFrames >= SUBPAGES) {
+            sim->faults2M++;
+            status = reclaimFrames(sim, SUBPAGES, -1) < 0 ? -1 : mapHugePage(sim, r);
+        } else {
+            sim->faults4K++;
+            status = reclaimFrames(sim, 1, -1) < 0 ? -1 : mapSubpage(sim, r, sub);
+            if (status == 0 && sim->config.thpMode == THP_PROMOTE && sim->totalFrames >= SUBPAGES &&
+                sim->regions[r].residentCount >= sim->config.promoteThreshold) {
+                // The faulting page counts as touched, so it survives a later demotion
+                memcpy(sim->regions[r].touched, sim->regions[r].resident, sizeof(sim->regions[r].touched));
+                status = promoteRegion(sim, r);
+            }
+        }
+        if (status < 0) {
+            printf("Out of memory for the huge page simulator\n");
+            return -1;
+        }
+    }
+
+    HugeRegion *region = &sim->regions[r];
+    if (region->huge) {
+        setBit(region->touched, sub);
+        sim->nodes[region->hugeNode].useBit = 1;
+        if (!tlbHit || !huge) tlbFill(sim->tlb2M, sim->config.tlbEntries2M, sim->config.tlbWays, (unsigned long long)number, sim->time);
+    } else {
+        sim->nodes[region->subNodes[sub]].useBit = 1;
+        if (!tlbHit) tlbFill(sim->tlb4K, sim->config.tlbEntries4K, sim->config.tlbWays, vpn, sim->time);
+    }
+
+    long long residentFrames = sim->totalFrames - sim->freeFrames;
+    sim->residentSum += residentFrames;
+    if (residentFrames > sim->peakFrames) sim->peakFrames = residentFrames;
+    return fault;
+}
+
+void printHugePageStats(const HugePageSim *sim, const char *label) {
+    double references = sim->references > 0 ? (double)sim->references : 1.0;
+    long long bloatFrames = 0;
+    long long hugePages = 0;
+    long long reachKiB = 0;
+
+    for (int r = 0; r < sim->regionCount; r++) {
+        if (sim->regions[r].huge) {
+            hugePages++;
+            bloatFrames += SUBPAGES - countBits(sim->regions[r].touched);
+        }
+    }
+    // Reach of the entries valid now, not of the TLB's capacity
+    for (int e = 0; e < sim->config.tlbEntries4K; e++) reachKiB += sim->tlb4K[e].valid ? 4 : 0;
+    for (int e = 0; e < sim->config.tlbEntries2M; e++) reachKiB += sim->tlb2M[e].valid ? 2048 : 0;
+
+    printf("%-22s faults 4K %lld, 2M %lld (%lld MiB read in), promotions %lld, demotions %lld, huge evictions %lld\n",
+           label, sim->faults4K, sim->faults2M, (sim->faults4K + sim->faults2M * SUBPAGES) >> 8,
+           sim->promotions, sim->demotions, sim->hugeEvictions);
+    printf("%-22s resident avg %.1f MiB, peak %lld MiB, huge pages %lld, bloat %lld MiB\n", "",
+           sim->residentSum / references / 256.0, sim->peakFrames >> 8, hugePages, bloatFrames >> 8);
+    printf("%-22s TLB hit rate %.4f, walk refs/ref %.4f, TLB reach %lld KiB\n", "",
+           sim->tlbHits / references, sim->walkReferences / references, reachKiB);
+}
+
+void hugePageSimFree(HugePageSim *sim) {
+    for (int r = 0; r < sim->regionCount; r++) free(sim->regions[r].subNodes);
+    free(sim->regions);
+    free(sim->nodes);
+    free(sim->tlb4K);
+    free(sim->tlb2M);
+    if (sim->regionIndex.slots != NULL) pageIndexFree(&sim->regionIndex);
+    sim->regions = NULL;
+    sim->nodes = NULL;
+    sim->tlb4K = sim->tlb2M = NULL;
+    sim->regionCount = 0;
+}
+
+int replayHugePageTrace(const char *path, const HugePageConfig *config) {
+    HugePageSim sim;
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &st) < 0 || st.st_size == 0 || st.st_size % sizeof(unsigned long long) != 0) {
+        printf("%s is not an address trace\n", path);
+        close(fd);
+        return -1;
+    }
+    const unsigned long long *addresses = (const unsigned long long *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addresses == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    if (hugePageSimInit(&sim, config) < 0) {
+        munmap((void *)addresses, st.st_size);
+        return -1;
+    }
+
+    long long count = st.st_size / sizeof(unsigned long long);
+    int status = 0;
+    for (long long i = 0; i < count && status >= 0; i++) {
+        status = hugePageAccess(&sim, addresses[i]);
+    }
+    printHugePageStats(&sim, path);
+
+    hugePageSimFree(&sim);
+    munmap((void *)addresses, st.st_size);
+    return status < 0 ? -1 : 0;
+}
+
+static unsigned long long randomOffset(unsigned long long range) {
+    return (((unsigned long long)rand() << 31) ^ (unsigned long long)rand()) % range;
+}
+
+int hugePageDemo() {
+    const int count = 2000000;
+    const int sparsePages = 16384;
+    unsigned long long *addresses = (unsigned long long *)malloc(sizeof(unsigned long long) * count);
+    unsigned long long *sparse = (unsigned long long *)malloc(sizeof(unsigned long long) * sparsePages);
+    unsigned long long scanBase = 0x7f0000000000ull;
+    unsigned long long hotBase = 0x550000000000ull;
+    const char *workloads[] = {"dense hot 128 MiB", "scan 512 MiB + hot", "sparse 64 MiB in 32 GiB"};
+
+    if (addresses == NULL || sparse == NULL) {
+        free(addresses);
+        free(sparse);
+        return -1;
+    }
+    // One 4 KiB page in each of 16384 random 2 MiB regions
+    for (int i = 0; i < sparsePages; i++) sparse[i] = hotBase + (randomOffset(32ull << 30) & ~4095ull);
+
+    // 256 MiB of memory, a 64-entry 4 KiB TLB and a 32-entry 2 MiB TLB, both 4-way
+    HugePageConfig configs[] = {
+        {THP_NEVER, SUBPAGES, 0, 256ll << 20, 64, 32, 4},
+        {THP_ALWAYS, SUBPAGES, SUBPAGES / 4, 256ll << 20, 64, 32, 4},
+        {THP_PROMOTE, SUBPAGES / 2, SUBPAGES / 4, 256ll << 20, 64, 32, 4},
+    };
+    const char *labels[] = {"never", "always", "promote at 256/512"};
+
+    for (int w = 0; w < 3; w++) {
+        unsigned long long scan = 0;
+        for (int i = 0; i < count; i++) {
+            if (w == 0) {
+                addresses[i] = hotBase + randomOffset(128ull << 20);
+            } else if (w == 1 && i % 4 == 0) {
+                addresses[i] = scanBase + scan;
+                scan = (scan + 1024) % (512ull << 20);
+            } else if (w == 1) {
+                addresses[i] = hotBase + randomOffset(16ull << 20);
+            } else {
+                addresses[i] = sparse[rand() % sparsePages] + randomOffset(4096);
+            }
+        }
+
+        printf("Huge page simulation, %s, %d references\n", workloads[w], count);
+        for (int c = 0; c < 3; c++) {
+            HugePageSim sim;
+            if (hugePageSimInit(&sim, &configs[c]) < 0) break;
+            for (int i = 0; i < count; i++) {
+                if (hugePageAccess(&sim, addresses[i]) < 0) break;
+            }
+            printHugePageStats(&sim, labels[c]);
+            hugePageSimFree(&sim);
+        }
+    }
+
+    free(addresses);
+    free(sparse);
+    return 0;
+}
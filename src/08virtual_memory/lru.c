@@ -38,16 +38,13 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include "page-policy.h"
+#include "page-trace.h"
 
 #define PAGE_SEQ_LEN 12
 #define NUMBER_OF_FRAMES 4
 
-// Structure for representing a page in memory
-typedef struct {
-    int number; // Page number
-    int lastUsedTime; // The last time this page was accessed
-} PageFrame;
-
 void initializePageFrames(PageFrame frames[]) {
     for (int i = 0; i < NUMBER_OF_FRAMES; i++) {
         frames[i].number = -1; // -1 indicates that the frame is initially empty
@@ -81,7 +78,7 @@ int findLRUPageFrameIndex(PageFrame frames[]) {
     return lruIndex;
 }
 
-void LRUPageReplacement(int pages[]) {
+int LRUPageReplacement(int pages[]) {
     PageFrame frames[NUMBER_OF_FRAMES];
     initializePageFrames(frames);
 
@@ -91,6 +88,7 @@ void LRUPageReplacement(int pages[]) {
     for (int i = 0; i < PAGE_SEQ_LEN; i++) {
         int currentPage = pages[i];
         int found = 0;
+        int evicted = -1;
 
         // Check if the page is already in one of the frames
         for (int j = 0; j < NUMBER_OF_FRAMES; j++) {
@@ -104,15 +102,21 @@ void LRUPageReplacement(int pages[]) {
         // If the page was not found in the frames
         if (!found) {
             int lruIndex = findLRUPageFrameIndex(frames);
+            evicted = frames[lruIndex].number;
             frames[lruIndex].number = currentPage; // Replace the LRU page with the new page
             frames[lruIndex].lastUsedTime = time++; // Update the last used time
             pageFaults++;
         }
-        printf("Processing page %d: ", currentPage);
-        printFrames(frames);
+        if (simOutputMode == SIM_OUTPUT_VERBOSE) {
+            printf("Processing page %d: ", currentPage);
+            printFrames(frames);
+        } else if (simOutputMode == SIM_OUTPUT_TRACE) {
+            emitPageEvent(currentPage, found, evicted, pageFaults < NUMBER_OF_FRAMES ? pageFaults : NUMBER_OF_FRAMES);
+        }
     }
 
-    printf("Total Page Faults: %d\n", pageFaults);
+    if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("Total Page Faults: %d\n", pageFaults);
+    return pageFaults;
 }
 
 int LRUDemo() {
@@ -123,3 +127,143 @@ int LRUDemo() {
 
     return 0;
 }
+
+// Step-by-step LRU with a run-time frame count, used by the trace replay engine
+int lruSimInit(LruSim *sim, int frameCount) {
+    sim->frames = (PageFrame *)malloc(sizeof(PageFrame) * frameCount);
+    if (sim->frames == NULL) return -1;
+    for (int i = 0; i < frameCount; i++) {
+        sim->frames[i].number = -1;
+        sim->frames[i].lastUsedTime = -1;
+    }
+    sim->frameCount = frameCount;
+    sim->time = 0;
+    return 0;
+}
+
+int lruSimAccess(LruSim *sim, int page) {
+    PageFrame *frames = sim->frames;
+    int lruIndex = 0;
+
+    // One scan both looks for the page and remembers the least recently used frame
+    for (int j = 0; j < sim->frameCount; j++) {
+        if (frames[j].number == page) {
+            frames[j].lastUsedTime = sim->time++;
+            return 0;
+        }
+        if (frames[j].lastUsedTime < frames[lruIndex].lastUsedTime) {
+            lruIndex = j;
+        }
+    }
+
+    frames[lruIndex].number = page;
+    frames[lruIndex].lastUsedTime = sim->time++;
+    return 1;
+}
+
+void lruSimFree(LruSim *sim) {
+    free(sim->frames);
+    sim->frames = NULL;
+}
+
+static void unlinkLruNode(LruHashSim *sim, int frame) {
+    LruNode *node = &sim->nodes[frame];
+    if (node->prev != -1) sim->nodes[node->prev].next = node->next;
+    else sim->head = node->next;
+    if (node->next != -1) sim->nodes[node->next].prev = node->prev;
+    else sim->tail = node->prev;
+}
+
+static void pushLruNode(LruHashSim *sim, int frame) {
+    LruNode *node = &sim->nodes[frame];
+    node->prev = -1;
+    node->next = sim->head;
+    if (sim->head != -1) sim->nodes[sim->head].prev = frame;
+    sim->head = frame;
+    if (sim->tail == -1) sim->tail = frame;
+}
+
+// LRU without scanning: hits and evictions only relink one node of the recency list
+int lruHashSimInit(LruHashSim *sim, int frameCount) {
+    sim->nodes = (LruNode *)malloc(sizeof(LruNode) * frameCount);
+    if (sim->nodes == NULL) return -1;
+    if (pageIndexInit(&sim->index, frameCount) < 0) {
+        free(sim->nodes);
+        sim->nodes = NULL;
+        return -1;
+    }
+    sim->frameCount = frameCount;
+    sim->usedFrames = 0;
+    sim->freeHead = -1;
+    sim->head = sim->tail = -1;
+    return 0;
+}
+
+int lruHashSimAccess(LruHashSim *sim, int page) {
+    int frame = pageIndexFind(&sim->index, page);
+
+    if (frame != -1) {
+        // Hit: move the frame to the most recently used end
+        if (frame != sim->head) {
+            unlinkLruNode(sim, frame);
+            pushLruNode(sim, frame);
+        }
+        return 0;
+    }
+
+    if (sim->freeHead != -1) {
+        frame = sim->freeHead; // Reuse a frame emptied by lruHashSimEvict()
+        sim->freeHead = sim->nodes[frame].next;
+    } else if (sim->usedFrames < sim->frameCount) {
+        frame = sim->usedFrames++; // Fill empty frames first
+    } else {
+        frame = sim->tail; // Replace the least recently used page
+        unlinkLruNode(sim, frame);
+        pageIndexRemove(&sim->index, sim->nodes[frame].pageNumber);
+    }
+    sim->nodes[frame].pageNumber = page;
+    pageIndexInsert(&sim->index, page, frame);
+    pushLruNode(sim, frame);
+    return 1;
+}
+
+int lruHashSimEvict(LruHashSim *sim) {
+    int frame = sim->tail;
+    if (frame == -1) return -1;
+
+    int page = sim->nodes[frame].pageNumber;
+    unlinkLruNode(sim, frame);
+    pageIndexRemove(&sim->index, page);
+    sim->nodes[frame].next = sim->freeHead;
+    sim->freeHead = frame;
+    return page;
+}
+
+int lruHashSimContains(const LruHashSim *sim, int page) {
+    return pageIndexFind(&sim->index, page) != -1;
+}
+
+void lruHashSimFree(LruHashSim *sim) {
+    pageIndexFree(&sim->index);
+    free(sim->nodes);
+    sim->nodes = NULL;
+}
+
+int LRUHashDemo() {
+    int pages[PAGE_SEQ_LEN] = {1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5};
+    LruHashSim sim;
+    int pageFaults = 0;
+
+    if (lruHashSimInit(&sim, NUMBER_OF_FRAMES) < 0) return -1;
+
+    printf("Starting O(1) LRU Page Replacement Simulation\n");
+    for (int i = 0; i < PAGE_SEQ_LEN; i++) {
+        int fault = lruHashSimAccess(&sim, pages[i]);
+        pageFaults += fault;
+        printf("Processing page %d: %s\n", pages[i], fault ? "fault" : "hit");
+    }
+    printf("Total Page Faults: %d\n", pageFaults);
+
+    lruHashSimFree(&sim);
+    return 0;
+}
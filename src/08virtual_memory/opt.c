@@ -0,0 +1,206 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Belady's optimal policy (OPT, also called MIN): on a fault, replace the
+    page whose next use lies furthest in the future. It needs the whole trace
+    in advance, so it is not a real policy, but it gives the smallest possible
+    number of faults. That tells us how far FIFO, LRU, Clock and the others
+    are from ideal.
+    The next use of every reference is found in one backward pass. Resident
+    pages sit in a max-heap keyed by their next use. On a hit, the page gets a
+    new entry with its new key, and the old entry is left behind. An old entry
+    has a key no later than now, and every live entry has a key after now, so
+    the top of the heap is always a live page. When the heap gets to twice the
+    number of frames, it is rebuilt from its live entries. Every reference
+    then costs O(log frames).
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+#define NEVER INT_MAX // Next use of a page that is not referenced again
+
+typedef struct {
+    int key; // Next use
+    int page;
+} HeapEntry;
+
+static void siftUp(HeapEntry heap[], int i) {
+    HeapEntry entry = heap[i];
+    while (i > 0 && heap[(i - 1) / 2].key < entry.key) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = entry;
+}
+
+static void siftDown(HeapEntry heap[], int size, int i) {
+    HeapEntry entry = heap[i];
+    while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && heap[child + 1].key > heap[child].key) child++;
+        if (heap[child].key <= entry.key) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = entry;
+}
+
+// nextUse[i] is the index of the next reference to pages[i], or NEVER
+int *computeNextUse(const int pages[], long long length) {
+    PageIndex lastSeen;
+    int *nextUse;
+
+    if (length >= NEVER) {
+        printf("Traces for OPT are limited to %d references\n", NEVER - 1);
+        return NULL;
+    }
+    nextUse = (int *)malloc(sizeof(int) * (length > 0 ? length : 1));
+    if (nextUse == NULL || pageIndexInit(&lastSeen, 1024) < 0) {
+        free(nextUse);
+        return NULL;
+    }
+    for (long long i = length - 1; i >= 0; i--) {
+        int seen = pageIndexFind(&lastSeen, pages[i]);
+        nextUse[i] = seen != -1 ? seen : NEVER;
+        if (seen == -1 && pageIndexReserve(&lastSeen, lastSeen.count + 1) < 0) {
+            free(nextUse);
+            pageIndexFree(&lastSeen);
+            return NULL;
+        }
+        pageIndexInsert(&lastSeen, pages[i], (int)i);
+    }
+    pageIndexFree(&lastSeen);
+    return nextUse;
+}
+
+long long optSimulate(const int pages[], const int nextUse[], long long length, int frameCount) {
+    HeapEntry *heap = (HeapEntry *)malloc(sizeof(HeapEntry) * 2 * frameCount);
+    PageIndex resident;
+    int heapSize = 0;
+    long long faults = 0;
+
+    if (heap == NULL || frameCount < 1 || pageIndexInit(&resident, frameCount) < 0) {
+        free(heap);
+        return -1;
+    }
+
+    for (long long i = 0; i < length; i++) {
+        int page = pages[i];
+
+        if (pageIndexFind(&resident, page) == -1) {
+            faults++;
+            if (resident.count == frameCount) {
+                // The top of the heap is the resident page used furthest in the future
+                pageIndexRemove(&resident, heap[0].page);
+                heap[0] = heap[--heapSize];
+                siftDown(heap, heapSize, 0);
+            }
+            pageIndexInsert(&resident, page, 1);
+        }
+
+        if (heapSize == 2 * frameCount) {
+            // Keep only live entries, whose next use is still ahead
+            int live = 0;
+            for (int h = 0; h < heapSize; h++) {
+                if (heap[h].key > i) heap[live++] = heap[h];
+            }
+            heapSize = live;
+            for (int h = heapSize / 2 - 1; h >= 0; h--) siftDown(heap, heapSize, h);
+        }
+        heap[heapSize].key = nextUse[i];
+        heap[heapSize].page = page;
+        siftUp(heap, heapSize++);
+    }
+
+    pageIndexFree(&resident);
+    free(heap);
+    return faults;
+}
+
+int compareWithOPT(const char *path, int frameCount) {
+    PageTrace trace;
+
+    if (mapPageTrace(path, &trace) < 0) return -1;
+    int *nextUse = computeNextUse(trace.pages, trace.length);
+    long long optFaults = nextUse != NULL ? optSimulate(trace.pages, nextUse, trace.length, frameCount) : -1;
+    free(nextUse);
+    if (optFaults < 0) {
+        printf("Could not run OPT on %s\n", path);
+        unmapPageTrace(&trace);
+        return -1;
+    }
+
+    printf("Trace %s: %lld references, %d frames\n", path, trace.length, frameCount);
+    printf("%-10s %14s %10s %14s %10s\n", "Policy", "Faults", "Hit ratio", "Over OPT", "Gap");
+    printf("%-10s %14lld %10.4f %14d %9.1f%%\n", "opt", optFaults, 1.0 - (double)optFaults / trace.length, 0, 0.0);
+    for (int p = 0; p < pagePolicyCount; p++) {
+        PagePolicy policy;
+        if (pagePolicyInit(&policy, pagePolicies[p], frameCount) < 0) continue;
+        for (long long i = 0; i < trace.length; i++) {
+            pagePolicyAccess(&policy, trace.pages[i]);
+        }
+        long long faults = policy.stats.faults;
+        printf("%-10s %14lld %10.4f %14lld %9.1f%%\n", policy.ops->name, faults,
+               1.0 - (double)faults / trace.length, faults - optFaults,
+               optFaults > 0 ? 100.0 * (faults - optFaults) / optFaults : 0.0);
+        pagePolicyFree(&policy);
+    }
+
+    unmapPageTrace(&trace);
+    return 0;
+}
+
+int OPTDemo() {
+    int pages[12] = {2, 3, 2, 1, 5, 2, 4, 5, 3, 2, 5, 2};
+    int *nextUse = computeNextUse(pages, 12);
+    if (nextUse == NULL) return -1;
+
+    // The textbook example: OPT needs 6 faults with 3 frames, FIFO 9 and LRU 7
+    for (int frames = 3; frames <= 4; frames++) {
+        FifoSim fifoSim;
+        LruHashSim lruSim;
+        int fifoFaults = 0, lruFaults = 0;
+        if (fifoSimInit(&fifoSim, frames) < 0 || lruHashSimInit(&lruSim, frames) < 0) break;
+        for (int i = 0; i < 12; i++) {
+            fifoFaults += fifoSimAccess(&fifoSim, pages[i]);
+            lruFaults += lruHashSimAccess(&lruSim, pages[i]);
+        }
+        printf("%d frames: OPT %lld faults, FIFO %d, LRU %d\n", frames,
+               optSimulate(pages, nextUse, 12, frames), fifoFaults, lruFaults);
+        fifoSimFree(&fifoSim);
+        lruHashSimFree(&lruSim);
+    }
+
+    free(nextUse);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Page number to frame index hash table for the page replacement simulators.
+    It uses open addressing with linear probing and is sized to at most half
+    full for the largest resident set, so a lookup touches one or two slots no
+    matter how many frames there are. Removal shifts later entries of the probe
+    run back instead of leaving tombstones, so the table never needs a rebuild.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdlib.h>
+#include "page-policy.h"
+
+#define EMPTY_SLOT -1
+
+static unsigned slotFor(const PageIndex *index, int page) {
+    // Fibonacci hashing spreads sequential page numbers over the table
+    return ((unsigned)page * 2654435769u) >> index->shift;
+}
+
+int pageIndexInit(PageIndex *index, int capacity) {
+    int bits = 1;
+    while ((1u << bits) < 2u * (unsigned)capacity) bits++;
+
+    index->slots = (PageSlot *)malloc(sizeof(PageSlot) << bits);
+    if (index->slots == NULL) return -1;
+    index->mask = (1u << bits) - 1;
+    index->shift = 32 - bits;
+    index->count = 0;
+    for (unsigned i = 0; i <= index->mask; i++) {
+        index->slots[i].page = EMPTY_SLOT;
+    }
+    return 0;
+}
+
+int pageIndexFind(const PageIndex *index, int page) {
+    unsigned i = slotFor(index, page);
+    while (index->slots[i].page != EMPTY_SLOT) {
+        if (index->slots[i].page == page) {
+            return index->slots[i].frame;
+        }
+        i = (i + 1) & index->mask;
+    }
+    return -1; // Page is not resident
+}
+
+void pageIndexInsert(PageIndex *index, int page, int frame) {
+    unsigned i = slotFor(index, page);
+    while (index->slots[i].page != EMPTY_SLOT && index->slots[i].page != page) {
+        i = (i + 1) & index->mask;
+    }
+    if (index->slots[i].page == EMPTY_SLOT) index->count++;
+    index->slots[i].page = page;
+    index->slots[i].frame = frame;
+}
+
+void pageIndexRemove(PageIndex *index, int page) {
+    unsigned i = slotFor(index, page);
+    while (index->slots[i].page != page) {
+        if (index->slots[i].page == EMPTY_SLOT) return; // Not in the table
+        i = (i + 1) & index->mask;
+    }
+
+    // Move later entries of the same probe run into the hole
+    unsigned hole = i;
+    for (unsigned j = (i + 1) & index->mask; index->slots[j].page != EMPTY_SLOT; j = (j + 1) & index->mask) {
+        unsigned home = slotFor(index, index->slots[j].page);
+        // The entry may fill the hole only if its home slot is not between the hole and j
+        if (((j - home) & index->mask) >= ((j - hole) & index->mask)) {
+            index->slots[hole] = index->slots[j];
+            hole = j;
+        }
+    }
+    index->slots[hole].page = EMPTY_SLOT;
+    index->count--;
+}
+
+int pageIndexReserve(PageIndex *index, int capacity) {
+    if (2u * (unsigned)capacity <= index->mask + 1) return 0; // Already big enough
+
+    PageIndex bigger;
+    if (pageIndexInit(&bigger, capacity) < 0) return -1;
+    for (unsigned i = 0; i <= index->mask; i++) {
+        if (index->slots[i].page != EMPTY_SLOT) {
+            pageIndexInsert(&bigger, index->slots[i].page, index->slots[i].frame);
+        }
+    }
+    pageIndexFree(index);
+    *index = bigger;
+    return 0;
+}
+
+void pageIndexFree(PageIndex *index) {
+    free(index->slots);
+    index->slots = NULL;
+}
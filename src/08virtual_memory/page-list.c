@@ -0,0 +1,126 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Doubly linked page lists for the replacement policies that keep more than
+    one list (ARC, CAR, 2Q and CLOCK-Pro). All nodes live in one array and are
+    linked by index, like the LRU recency list in lru.c. A page index maps each
+    page number to its node, so a policy finds a page, and the list it is on,
+    with one lookup. A node is either on one list or on the pool's free list.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdlib.h>
+#include "page-policy.h"
+
+int nodePoolInit(NodePool *pool, int capacity) {
+    pool->nodes = (ListNode *)malloc(sizeof(ListNode) * capacity);
+    if (pool->nodes == NULL) return -1;
+    if (pageIndexInit(&pool->index, capacity) < 0) {
+        free(pool->nodes);
+        pool->nodes = NULL;
+        return -1;
+    }
+    for (int i = 0; i < capacity; i++) {
+        pool->nodes[i].next = i + 1 < capacity ? i + 1 : -1;
+    }
+    pool->freeHead = 0;
+    return 0;
+}
+
+int nodePoolAlloc(NodePool *pool, int page) {
+    int node = pool->freeHead;
+    if (node == -1) return -1; // Callers size the pool so this does not happen
+
+    pool->freeHead = pool->nodes[node].next;
+    pool->nodes[node].page = page;
+    pool->nodes[node].prev = pool->nodes[node].next = -1;
+    pool->nodes[node].list = 0;
+    pool->nodes[node].flags = 0;
+    pageIndexInsert(&pool->index, page, node);
+    return node;
+}
+
+void nodePoolRelease(NodePool *pool, int node) {
+    pageIndexRemove(&pool->index, pool->nodes[node].page);
+    pool->nodes[node].next = pool->freeHead;
+    pool->freeHead = node;
+}
+
+void nodePoolFree(NodePool *pool) {
+    pageIndexFree(&pool->index);
+    free(pool->nodes);
+    pool->nodes = NULL;
+}
+
+void pageListInit(PageList *list) {
+    list->head = list->tail = -1;
+    list->size = 0;
+}
+
+void pageListPushHead(NodePool *pool, PageList *list, int node) {
+    ListNode *nodes = pool->nodes;
+    nodes[node].prev = -1;
+    nodes[node].next = list->head;
+    if (list->head != -1) nodes[list->head].prev = node;
+    else list->tail = node;
+    list->head = node;
+    list->size++;
+}
+
+void pageListPushTail(NodePool *pool, PageList *list, int node) {
+    ListNode *nodes = pool->nodes;
+    nodes[node].next = -1;
+    nodes[node].prev = list->tail;
+    if (list->tail != -1) nodes[list->tail].next = node;
+    else list->head = node;
+    list->tail = node;
+    list->size++;
+}
+
+void pageListInsertBefore(NodePool *pool, PageList *list, int before, int node) {
+    ListNode *nodes = pool->nodes;
+    if (before == -1) {
+        pageListPushTail(pool, list, node);
+        return;
+    }
+    nodes[node].next = before;
+    nodes[node].prev = nodes[before].prev;
+    if (nodes[before].prev != -1) nodes[nodes[before].prev].next = node;
+    else list->head = node;
+    nodes[before].prev = node;
+    list->size++;
+}
+
+void pageListRemove(NodePool *pool, PageList *list, int node) {
+    ListNode *nodes = pool->nodes;
+    if (nodes[node].prev != -1) nodes[nodes[node].prev].next = nodes[node].next;
+    else list->head = nodes[node].next;
+    if (nodes[node].next != -1) nodes[nodes[node].next].prev = nodes[node].prev;
+    else list->tail = nodes[node].prev;
+    list->size--;
+}
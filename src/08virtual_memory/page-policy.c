@@ -0,0 +1,179 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Common interface over the page replacement policies. Every policy is
+    described by a PagePolicyOps table of init/access/evict/free functions, so
+    FIFO, LRU and Clock and the scan-resistant ARC, CAR, 2Q and CLOCK-Pro can
+    all be driven by the same code. The wrapper keeps the statistics, and
+    benchmarkPolicies() runs all of them on one trace for comparison.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+// Wrappers with the exact types of the PagePolicyOps slots; calling the typed functions through a cast pointer is undefined
+#define POLICY_WRAPPERS(type, prefix) \
+    static int prefix##OpsInit(void *sim, int frameCount) { return prefix##Init((type *)sim, frameCount); } \
+    static int prefix##OpsAccess(void *sim, int page) { return prefix##Access((type *)sim, page); } \
+    static int prefix##OpsEvict(void *sim) { return prefix##Evict((type *)sim); } \
+    static void prefix##OpsFree(void *sim) { prefix##Free((type *)sim); } \
+    static int prefix##OpsContains(const void *sim, int page) { return prefix##Contains((const type *)sim, page); }
+#define POLICY_OPS(label, type, prefix, prefetch) { label, sizeof(type), prefix##OpsInit, prefix##OpsAccess, \
+    prefix##OpsEvict, prefix##OpsFree, prefix##OpsContains, prefetch }
+
+POLICY_WRAPPERS(FifoSim, fifoSim)
+POLICY_WRAPPERS(LruHashSim, lruHashSim)
+POLICY_WRAPPERS(ClockHashSim, clockHashSim)
+POLICY_WRAPPERS(ArcSim, arcSim)
+POLICY_WRAPPERS(CarSim, carSim)
+POLICY_WRAPPERS(TwoQueueSim, twoQueueSim)
+POLICY_WRAPPERS(ClockProSim, clockProSim)
+
+static int clockHashSimOpsPrefetch(void *sim, int page) { return clockHashSimPrefetch((ClockHashSim *)sim, page); }
+static int arcSimOpsPrefetch(void *sim, int page) { return arcSimPrefetch((ArcSim *)sim, page); }
+static int carSimOpsPrefetch(void *sim, int page) { return carSimPrefetch((CarSim *)sim, page); }
+static int twoQueueSimOpsPrefetch(void *sim, int page) { return twoQueueSimPrefetch((TwoQueueSim *)sim, page); }
+static int clockProSimOpsPrefetch(void *sim, int page) { return clockProSimPrefetch((ClockProSim *)sim, page); }
+
+static const PagePolicyOps fifoOps = POLICY_OPS("fifo", FifoSim, fifoSim, NULL);
+static const PagePolicyOps lruOps = POLICY_OPS("lru", LruHashSim, lruHashSim, NULL);
+static const PagePolicyOps clockOps = POLICY_OPS("clock", ClockHashSim, clockHashSim, clockHashSimOpsPrefetch);
+static const PagePolicyOps arcOps = POLICY_OPS("arc", ArcSim, arcSim, arcSimOpsPrefetch);
+static const PagePolicyOps carOps = POLICY_OPS("car", CarSim, carSim, carSimOpsPrefetch);
+static const PagePolicyOps twoQueueOps = POLICY_OPS("2q", TwoQueueSim, twoQueueSim, twoQueueSimOpsPrefetch);
+static const PagePolicyOps clockProOps = POLICY_OPS("clock-pro", ClockProSim, clockProSim, clockProSimOpsPrefetch);
+
+const PagePolicyOps *const pagePolicies[] = {
+    &fifoOps, &lruOps, &clockOps, &arcOps, &carOps, &twoQueueOps, &clockProOps
+};
+const int pagePolicyCount = sizeof(pagePolicies) / sizeof(pagePolicies[0]);
+
+const PagePolicyOps *findPagePolicy(const char *name) {
+    for (int i = 0; i < pagePolicyCount; i++) {
+        if (strcmp(pagePolicies[i]->name, name) == 0) return pagePolicies[i];
+    }
+    return NULL;
+}
+
+int pagePolicyInit(PagePolicy *policy, const PagePolicyOps *ops, int frameCount) {
+    memset(policy, 0, sizeof(*policy));
+    if (ops == NULL || frameCount < 1) return -1;
+    policy->sim = malloc(ops->simSize);
+    if (policy->sim == NULL) return -1;
+    if (ops->init(policy->sim, frameCount) < 0) {
+        free(policy->sim);
+        policy->sim = NULL;
+        return -1;
+    }
+    policy->ops = ops;
+    return 0;
+}
+
+int pagePolicyAccess(PagePolicy *policy, int page) {
+    int fault = policy->ops->access(policy->sim, page);
+    policy->stats.references++;
+    policy->stats.faults += fault;
+    return fault;
+}
+
+int pagePolicyEvict(PagePolicy *policy) {
+    int page = policy->ops->evict(policy->sim);
+    if (page != -1) policy->stats.evictions++;
+    return page;
+}
+
+int pagePolicyContains(const PagePolicy *policy, int page) {
+    return policy->ops->contains(policy->sim, page);
+}
+
+void pagePolicyFree(PagePolicy *policy) {
+    if (policy->sim != NULL) {
+        policy->ops->free(policy->sim);
+        free(policy->sim);
+    }
+    policy->sim = NULL;
+}
+
+int benchmarkPolicies(const char *path, int frameCount) {
+    PageTrace trace;
+
+    if (mapPageTrace(path, &trace) < 0) return -1;
+
+    printf("Trace %s: %lld references, %d frames\n", path, trace.length, frameCount);
+    printf("%-10s %14s %10s %12s\n", "Policy", "Faults", "Hit ratio", "ns/access");
+    for (int i = 0; i < pagePolicyCount; i++) {
+        PagePolicy policy;
+        struct timespec t0, t1;
+
+        if (pagePolicyInit(&policy, pagePolicies[i], frameCount) < 0) {
+            printf("%-10s out of memory\n", pagePolicies[i]->name);
+            continue;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (long long r = 0; r < trace.length; r++) {
+            pagePolicyAccess(&policy, trace.pages[r]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / trace.length;
+        printf("%-10s %14lld %10.4f %12.1f\n", policy.ops->name, policy.stats.faults,
+               1.0 - (double)policy.stats.faults / trace.length, ns);
+        pagePolicyFree(&policy);
+    }
+
+    unmapPageTrace(&trace);
+    return 0;
+}
+
+int scanResistanceDemo() {
+    const char *path = "scan-resistance-demo.bin";
+    int length = 2000000;
+    int *pages = (int *)malloc(sizeof(int) * length);
+    int scanPage = 1000;
+    if (pages == NULL) return -1;
+
+    // A hot set of 300 pages, interrupted every 5000 references by a scan of 2000 new pages
+    for (int i = 0; i < length; i++) {
+        if (i % 7000 >= 5000) {
+            pages[i] = scanPage++;
+        } else {
+            pages[i] = rand() % 300;
+        }
+    }
+    int result = writePageTrace(path, pages, length);
+    free(pages);
+
+    if (result == 0) result = benchmarkPolicies(path, 500);
+    remove(path);
+    return result;
+}
@@ -0,0 +1,227 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Page reference tracer for Linux. It records which pages of a memory region
+    a running program touches, so the replacement simulators can be run on real
+    access patterns instead of rand() sequences.
+    The region is protected with mprotect(PROT_NONE). Every access to a
+    protected page raises SIGSEGV. The handler logs the page and unprotects it,
+    and then the faulting instruction runs again. Only the last `window` pages
+    touched stay unprotected. When a new page is opened, the oldest one in the
+    window is protected again, so its next use is caught. The window must hold
+    at least 2 pages: an access that crosses a page boundary faults once for
+    each page, and with a single slot the second fault would protect the first
+    page again, so the instruction would fault forever. With a window of 2 the
+    trace misses re-references to the last two pages only. Larger windows lose
+    more of those references but make far fewer faults.
+    The output is a raw int trace (see page-trace.h) that replayTrace() reads
+    directly. The handler only uses mprotect() and write(), both plain system
+    calls that are safe to make from a signal handler on Linux. The tracer
+    assumes one thread at a time touches the region.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "page-trace.h"
+
+#define TRACER_BUFFER 4096 // References held before they are written out
+#define MIN_TRACER_WINDOW 2 // One access can span two pages
+#define MAX_TRACER_WINDOW 64
+
+static struct {
+    char *base;
+    size_t length;
+    long pageSize;
+    int fd;
+    int buffer[TRACER_BUFFER];
+    int used;
+    int window[MAX_TRACER_WINDOW]; // Unprotected pages, oldest at windowNext
+    int windowSize;
+    int windowNext;
+    long long references;
+    int failed; // A write to the trace file failed
+    volatile sig_atomic_t active;
+    struct sigaction previous;
+} tracer;
+
+static void flushTracer() {
+    size_t bytes = sizeof(int) * tracer.used;
+    const char *data = (const char *)tracer.buffer;
+    while (bytes > 0) {
+        ssize_t written = write(tracer.fd, data, bytes);
+        if (written <= 0) {
+            tracer.failed = 1;
+            break;
+        }
+        data += written;
+        bytes -= written;
+    }
+    tracer.used = 0;
+}
+
+static void tracerHandler(int sig, siginfo_t *info, void *context) {
+    char *address = (char *)info->si_addr;
+
+    if (!tracer.active || address < tracer.base || address >= tracer.base + tracer.length) {
+        // Not one of ours: hand the fault to whoever was there before us
+        if ((tracer.previous.sa_flags & SA_SIGINFO) && tracer.previous.sa_sigaction != NULL) {
+            tracer.previous.sa_sigaction(sig, info, context);
+        } else if (tracer.previous.sa_handler != SIG_DFL && tracer.previous.sa_handler != SIG_IGN) {
+            tracer.previous.sa_handler(sig);
+        } else {
+            sigaction(SIGSEGV, &tracer.previous, NULL); // The access faults again and takes the default action
+        }
+        return;
+    }
+
+    int page = (int)((address - tracer.base) / tracer.pageSize);
+    int oldest = tracer.window[tracer.windowNext];
+    if (oldest != -1) {
+        mprotect(tracer.base + (size_t)oldest * tracer.pageSize, tracer.pageSize, PROT_NONE);
+    }
+    tracer.window[tracer.windowNext] = page;
+    tracer.windowNext = (tracer.windowNext + 1) % tracer.windowSize;
+    mprotect(tracer.base + (size_t)page * tracer.pageSize, tracer.pageSize, PROT_READ | PROT_WRITE);
+
+    tracer.buffer[tracer.used++] = page;
+    tracer.references++;
+    if (tracer.used == TRACER_BUFFER) flushTracer();
+}
+
+int startPageTracer(void *region, size_t length, const char *outPath, int window) {
+    struct sigaction action;
+
+    if (tracer.active) {
+        printf("The page tracer is already running\n");
+        return -1;
+    }
+    if (window < MIN_TRACER_WINDOW || window > MAX_TRACER_WINDOW) {
+        printf("Tracer window must be between %d and %d pages\n", MIN_TRACER_WINDOW, MAX_TRACER_WINDOW);
+        return -1;
+    }
+    tracer.pageSize = sysconf(_SC_PAGESIZE);
+    if ((size_t)region % tracer.pageSize != 0 || length == 0) {
+        printf("The traced region must be page aligned and not empty\n");
+        return -1;
+    }
+
+    tracer.fd = open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (tracer.fd < 0) {
+        perror("open");
+        return -1;
+    }
+    tracer.base = (char *)region;
+    tracer.length = length;
+    tracer.used = 0;
+    tracer.references = 0;
+    tracer.failed = 0;
+    tracer.windowSize = window;
+    tracer.windowNext = 0;
+    for (int i = 0; i < MAX_TRACER_WINDOW; i++) tracer.window[i] = -1;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = tracerHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &tracer.previous) < 0) {
+        perror("sigaction");
+        close(tracer.fd);
+        return -1;
+    }
+
+    tracer.active = 1;
+    if (mprotect(region, length, PROT_NONE) < 0) {
+        perror("mprotect");
+        tracer.active = 0;
+        sigaction(SIGSEGV, &tracer.previous, NULL);
+        close(tracer.fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Stop tracing and leave the region readable and writable. Returns the number
+// of references written, or -1 if the trace file could not be written.
+long long stopPageTracer() {
+    if (!tracer.active) return -1;
+
+    mprotect(tracer.base, tracer.length, PROT_READ | PROT_WRITE);
+    tracer.active = 0;
+    sigaction(SIGSEGV, &tracer.previous, NULL);
+
+    flushTracer();
+    if (close(tracer.fd) < 0) tracer.failed = 1;
+    if (tracer.failed) {
+        printf("Could not write the page trace\n");
+        return -1;
+    }
+    return tracer.references;
+}
+
+int pageTracerDemo() {
+    const char *path = "page-tracer-demo.bin";
+    long pageSize = sysconf(_SC_PAGESIZE);
+    int pages = 64;
+    size_t length = (size_t)pages * pageSize;
+
+    char *region = (char *)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    if (startPageTracer(region, length, path, MIN_TRACER_WINDOW) < 0) {
+        munmap(region, length);
+        return -1;
+    }
+
+    // Workload: a hot set of 6 pages, with a sequential scan of the region now and then
+    for (int round = 0; round < 200; round++) {
+        if (round % 50 == 0) {
+            for (int p = 0; p < pages; p++) region[(size_t)p * pageSize] += 1;
+        }
+        for (int i = 0; i < 20; i++) {
+            int p = rand() % 6;
+            region[(size_t)p * pageSize + rand() % pageSize] += 1;
+        }
+    }
+
+    long long references = stopPageTracer();
+    munmap(region, length);
+    if (references < 0) return -1;
+
+    printf("Traced %lld page references\n", references);
+    int result = replayTrace(path, 8);
+    unlink(path);
+    return result;
+}
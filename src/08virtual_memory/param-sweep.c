@@ -0,0 +1,230 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Parameter sweep for PFF and VSWS. Instead of editing UPPER_PFF_LIMIT,
+    LOWER_PFF_LIMIT and ADJUSTMENT_INTERVAL (or M, L and Q) and rerunning by
+    hand, we give a list of values for each parameter and every combination is
+    simulated. The trace is mapped once and shared read-only. One worker thread
+    per core takes the next parameter tuple from a shared counter and replays
+    the whole trace with it. The result is a table of fault rate and average
+    resident set size for each tuple.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+#define SWEEP_PFF 0
+#define SWEEP_VSWS 1
+
+typedef struct {
+    int params[3]; // PFF: upper, lower, interval. VSWS: M, L, Q
+    long long faults;
+    long long residentSum; // Resident set size summed over all references
+    int failed;
+} SweepJob;
+
+typedef struct {
+    const PageTrace *trace;
+    int policy;
+    int maxFrames;
+    SweepJob *jobs;
+    int jobCount;
+    int nextJob;
+    pthread_mutex_t mutex;
+} SweepShared;
+
+static void runSweepJob(SweepShared *shared, SweepJob *job) {
+    const int *pages = shared->trace->pages;
+    long long length = shared->trace->length;
+    long long faults = 0;
+    long long residentSum = 0;
+
+    if (shared->policy == SWEEP_PFF) {
+        PffSim sim;
+        if (pffSimInit(&sim, shared->maxFrames, job->params[0], job->params[1], job->params[2]) < 0) {
+            job->failed = 1;
+            return;
+        }
+        for (long long i = 0; i < length; i++) {
+            faults += pffSimAccess(&sim, pages[i]);
+            residentSum += sim.frameCount;
+        }
+        pffSimFree(&sim);
+    } else {
+        VswsSim sim;
+        if (vswsSimInit(&sim, shared->maxFrames, job->params[0], job->params[1], job->params[2]) < 0) {
+            job->failed = 1;
+            return;
+        }
+        for (long long i = 0; i < length; i++) {
+            faults += vswsSimAccess(&sim, pages[i]);
+            residentSum += sim.ws.size;
+        }
+        vswsSimFree(&sim);
+    }
+    job->faults = faults;
+    job->residentSum = residentSum;
+}
+
+static void *sweepWorker(void *arg) {
+    SweepShared *shared = (SweepShared *)arg;
+
+    while (1) {
+        pthread_mutex_lock(&shared->mutex);
+        int job = shared->nextJob++;
+        pthread_mutex_unlock(&shared->mutex);
+        if (job >= shared->jobCount) break;
+        runSweepJob(shared, &shared->jobs[job]);
+    }
+    return NULL;
+}
+
+static int runSweep(const char *path, int policy, int maxFrames, const int *grids[3], const int counts[3]) {
+    const char *labels[2][3] = {{"upper", "lower", "interval"}, {"M", "L", "Q"}};
+    SweepShared shared;
+    PageTrace trace;
+
+    if (maxFrames < 1) {
+        printf("Frame count must be at least 1\n");
+        return -1;
+    }
+    // The PFF interval is a divisor and the VSWS L a window length, so both must be positive
+    int positiveParam = policy == SWEEP_PFF ? 2 : 1;
+    for (int v = 0; v < counts[positiveParam]; v++) {
+        if (grids[positiveParam][v] < 1) {
+            printf("%s must be at least 1\n", labels[policy][positiveParam]);
+            return -1;
+        }
+    }
+    if (mapPageTrace(path, &trace) < 0) return -1;
+
+    shared.trace = &trace;
+    shared.policy = policy;
+    shared.maxFrames = maxFrames;
+    shared.jobCount = counts[0] * counts[1] * counts[2];
+    shared.nextJob = 0;
+    shared.jobs = (SweepJob *)calloc(shared.jobCount, sizeof(SweepJob));
+    if (shared.jobs == NULL) {
+        unmapPageTrace(&trace);
+        return -1;
+    }
+    for (int j = 0; j < shared.jobCount; j++) {
+        shared.jobs[j].params[0] = grids[0][j / (counts[1] * counts[2])];
+        shared.jobs[j].params[1] = grids[1][(j / counts[2]) % counts[1]];
+        shared.jobs[j].params[2] = grids[2][j % counts[2]];
+    }
+    pthread_mutex_init(&shared.mutex, NULL);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCount = cores > 0 ? (int)cores : 1;
+    if (threadCount > shared.jobCount) threadCount = shared.jobCount;
+    pthread_t *threads = (pthread_t *)malloc(sizeof(pthread_t) * threadCount);
+    int started = 0;
+    if (threads != NULL) {
+        for (; started < threadCount; started++) {
+            if (pthread_create(&threads[started], NULL, sweepWorker, &shared) != 0) break;
+        }
+    }
+    if (started == 0) {
+        sweepWorker(&shared); // No threads available, run every job here
+    }
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    printf("%s sweep over %s: %lld references, up to %d frames, %d thread(s)\n",
+           policy == SWEEP_PFF ? "PFF" : "VSWS", path, trace.length, maxFrames, started > 0 ? started : 1);
+    printf("%8s %8s %8s %14s %10s %12s\n", labels[policy][0], labels[policy][1], labels[policy][2],
+           "Faults", "Fault rate", "Avg frames");
+    for (int j = 0; j < shared.jobCount; j++) {
+        SweepJob *job = &shared.jobs[j];
+        if (job->failed) {
+            printf("%8d %8d %8d   out of memory\n", job->params[0], job->params[1], job->params[2]);
+            continue;
+        }
+        printf("%8d %8d %8d %14lld %10.4f %12.2f\n", job->params[0], job->params[1], job->params[2],
+               job->faults, (double)job->faults / trace.length, (double)job->residentSum / trace.length);
+    }
+
+    pthread_mutex_destroy(&shared.mutex);
+    free(threads);
+    free(shared.jobs);
+    unmapPageTrace(&trace);
+    return 0;
+}
+
+int sweepPFF(const char *path, int maxFrames, const int uppers[], int upperCount,
+             const int lowers[], int lowerCount, const int intervals[], int intervalCount) {
+    const int *grids[3] = {uppers, lowers, intervals};
+    const int counts[3] = {upperCount, lowerCount, intervalCount};
+    return runSweep(path, SWEEP_PFF, maxFrames, grids, counts);
+}
+
+int sweepVSWS(const char *path, int maxFrames, const int Ms[], int MCount,
+              const int Ls[], int LCount, const int Qs[], int QCount) {
+    const int *grids[3] = {Ms, Ls, Qs};
+    const int counts[3] = {MCount, LCount, QCount};
+    return runSweep(path, SWEEP_VSWS, maxFrames, grids, counts);
+}
+
+int paramSweepDemo() {
+    const char *path = "param-sweep-demo.bin";
+    int length = 1000000;
+    int *pages = (int *)malloc(sizeof(int) * length);
+    if (pages == NULL) return -1;
+
+    // Same shape as PFFDemo(): phases with a narrow and a wider locality
+    for (int i = 0; i < length; i++) {
+        if (i % 40 < 20) {
+            pages[i] = rand() % 5;
+        } else {
+            pages[i] = rand() % 10 + 5;
+        }
+    }
+    int result = writePageTrace(path, pages, length);
+    free(pages);
+
+    if (result == 0) {
+        int uppers[] = {5, 7, 9};
+        int lowers[] = {2, 4};
+        int intervals[] = {5, 10, 20};
+        int Ms[] = {10};
+        int Ls[] = {10, 20, 40};
+        int Qs[] = {5, 11, 20};
+
+        result = sweepPFF(path, 10, uppers, 3, lowers, 2, intervals, 3);
+        if (result == 0) result = sweepVSWS(path, 20, Ms, 1, Ls, 3, Qs, 3);
+    }
+    unlink(path);
+    return result;
+}
@@ -33,6 +33,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "page-policy.h"
+#include "page-trace.h"
 
 #define MAX_PAGES 200
 #define MAX_FRAMES 10
@@ -42,50 +44,53 @@
 
 // Function to check if a page is in the set
 int isInMemory(int page, int frames[], int frameCount) {
-    for (int i = 0; i < frameCount; i++) {
-        if (frames[i] == page) {
-            return 1; // Page is in memory
-        }
-    }
-    return 0; // Page is not in memory
+    return findPageSimd(frames, frameCount, page) != -1;
 }
 
 // PFF algorithm simulation
-void simulatePFF(int pages[]) {
+int simulatePFF(int pages[]) {
     int frames[MAX_FRAMES] = {0};
     int frameCount = 3; // Starting frame count
     int pageFaults = 0;
+    int totalFaults = 0;
     int referenceCounter = 0;
     int pointer = 0;
 
     for (int i = 0; i < MAX_PAGES; i++) {
+        int hit = isInMemory(pages[i], frames, frameCount);
+        int evicted = -1;
+
         referenceCounter++;
-        if (!isInMemory(pages[i], frames, frameCount)) {
+        if (!hit) {
             // Page fault occurred
+            evicted = frames[pointer];
             frames[pointer] = pages[i];
             pointer = (pointer + 1) % frameCount;
             pageFaults++;
-            printf("Time: %d; Page fault for page %d\n", i, pages[i]);
+            totalFaults++;
+            if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("Time: %d; Page fault for page %d\n", i, pages[i]);
         }
-        else{
+        else if (simOutputMode == SIM_OUTPUT_VERBOSE) {
             printf("Time %d; Page %d hit!\n", i, pages[i]);
         }
+        if (simOutputMode == SIM_OUTPUT_TRACE) emitPageEvent(pages[i], hit, evicted, frameCount);
 
 
         // Check if we need to adjust the frame count after every ADJUSTMENT_INTERVAL references
         if (referenceCounter % ADJUSTMENT_INTERVAL == 0) {
             if (pageFaults >= UPPER_PFF_LIMIT && frameCount < MAX_FRAMES) {
                 frameCount++; // Increase the frame count
-                printf("Increasing frame count to %d due to high page fault frequency.\n", frameCount);
+                if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("Increasing frame count to %d due to high page fault frequency.\n", frameCount);
             } else if (pageFaults <= LOWER_PFF_LIMIT && frameCount > 1) {
                 frameCount--; // Decrease the frame count
-                printf("Decreasing frame count to %d due to low page fault frequency.\n", frameCount);
+                if (simOutputMode == SIM_OUTPUT_VERBOSE) printf("Decreasing frame count to %d due to low page fault frequency.\n", frameCount);
             }
             // Reset page fault count for the next interval
             pageFaults = 0;
         }
 
     }
+    return totalFaults;
 }
 
 int PFFDemo() {
@@ -106,3 +111,49 @@ int PFFDemo() {
     return 0;
 }
 
+// Step-by-step PFF with run-time limits, used by the trace replay engine
+int pffSimInit(PffSim *sim, int maxFrames, int upperLimit, int lowerLimit, int interval) {
+    sim->frames = (int *)malloc(sizeof(int) * maxFrames);
+    if (sim->frames == NULL) return -1;
+    for (int i = 0; i < maxFrames; i++) {
+        sim->frames[i] = -1;
+    }
+    sim->maxFrames = maxFrames;
+    sim->frameCount = maxFrames < 3 ? maxFrames : 3; // Starting frame count, as in simulatePFF()
+    sim->upperLimit = upperLimit;
+    sim->lowerLimit = lowerLimit;
+    sim->interval = interval;
+    sim->pointer = 0;
+    sim->intervalFaults = 0;
+    sim->referenceCounter = 0;
+    return 0;
+}
+
+int pffSimAccess(PffSim *sim, int page) {
+    int fault = 0;
+
+    sim->referenceCounter++;
+    if (!isInMemory(page, sim->frames, sim->frameCount)) {
+        sim->frames[sim->pointer] = page;
+        sim->pointer = (sim->pointer + 1) % sim->frameCount;
+        sim->intervalFaults++;
+        fault = 1;
+    }
+
+    if (sim->referenceCounter % sim->interval == 0) {
+        if (sim->intervalFaults >= sim->upperLimit && sim->frameCount < sim->maxFrames) {
+            sim->frameCount++;
+        } else if (sim->intervalFaults <= sim->lowerLimit && sim->frameCount > 1) {
+            sim->frameCount--;
+            sim->frames[sim->frameCount] = -1; // The frame taken away no longer holds a page
+            if (sim->pointer >= sim->frameCount) sim->pointer = 0;
+        }
+        sim->intervalFaults = 0;
+    }
+    return fault;
+}
+
+void pffSimFree(PffSim *sim) {
+    free(sim->frames);
+    sim->frames = NULL;
+}
@@ -0,0 +1,267 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Readahead in front of any replacement policy. The prefetcher watches demand
+    references for streams. A stream is a run of references a fixed stride
+    apart: 1 for a sequential scan, something else for a strided walk. It
+    tracks a few streams at once, so interleaved scans are still found. Once a
+    stream has followed its stride twice, the pages ahead of it are read in up
+    to a window. Every time the stream uses up half the window, the window
+    doubles, up to maxWindow. Like Linux readahead, it starts small and ramps up
+    on long scans.
+
+    Prefetched pages go into the policy through its prefetch hook, or through
+    an ordinary access when the policy has none, so they sit in the policy's
+    own structures like any other page. Clock loads them with the use bit clear.
+    ARC, CAR, 2Q and CLOCK-Pro load them as pages never seen before, and their
+    first demand reference counts as the first use, not as a reuse.
+    Pages that are already resident are skipped. Each prefetched page is
+    remembered until its fate is known. If it is referenced while resident, it
+    counts as useful. If it was evicted first, or is never referenced, it counts
+    as wasted.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+int prefetchSimInit(PrefetchSim *sim, const PagePolicyOps *ops, int frameCount, const PrefetchConfig *config) {
+    memset(sim, 0, sizeof(*sim));
+    if (config->minWindow < 1 || config->maxWindow < config->minWindow || config->streams < 1 ||
+        config->streams > PREFETCH_MAX_STREAMS || config->maxStride < 1) {
+        printf("Invalid prefetch configuration\n");
+        return -1;
+    }
+    if (pagePolicyInit(&sim->policy, ops, frameCount) < 0) return -1;
+    if (pageIndexInit(&sim->pending, config->maxWindow * 2) < 0) {
+        pagePolicyFree(&sim->policy);
+        return -1;
+    }
+    sim->config = *config;
+    for (int s = 0; s < PREFETCH_MAX_STREAMS; s++) {
+        sim->streams[s].lastPage = -1;
+        sim->streams[s].lastUse = -1;
+    }
+    return 0;
+}
+
+static int prefetchPage(PrefetchSim *sim, int page) {
+    const PagePolicyOps *ops = sim->policy.ops;
+
+    if (ops->contains(sim->policy.sim, page)) return 0;
+    if (pageIndexFind(&sim->pending, page) != -1) sim->wasted++; // Evicted unused, now read again
+    if (pageIndexReserve(&sim->pending, sim->pending.count + 1) < 0) return -1;
+    if (ops->prefetch != NULL) ops->prefetch(sim->policy.sim, page);
+    else ops->access(sim->policy.sim, page);
+    pageIndexInsert(&sim->pending, page, 1);
+    sim->issued++;
+    return 0;
+}
+
+// Read ahead so the stream has window pages in front of page
+static int readAhead(PrefetchSim *sim, PrefetchStream *stream, int page) {
+    long long ahead = (stream->frontier - page) / stream->stride;
+
+    if (ahead > stream->window / 2) return 0;
+    if (ahead > 0 && stream->window < sim->config.maxWindow) {
+        stream->window = stream->window * 2 < sim->config.maxWindow ? stream->window * 2 : sim->config.maxWindow;
+    }
+    if (ahead < 1) stream->frontier = (long long)page + stream->stride;
+
+    long long end = (long long)page + (long long)stream->window * stream->stride;
+    while ((stream->stride > 0 ? stream->frontier <= end : stream->frontier >= end)) {
+        if (stream->frontier < 0 || stream->frontier > INT_MAX) break; // Off either end of the page numbers
+        if (prefetchPage(sim, (int)stream->frontier) < 0) return -1;
+        stream->frontier += stream->stride;
+    }
+    return 0;
+}
+
+// Match a reference to a stream, start or retrain one, and read ahead on a confirmed stream
+static int trackStreams(PrefetchSim *sim, int page) {
+    PrefetchStream *match = NULL;
+    PrefetchStream *oldest = &sim->streams[0];
+
+    for (int s = 0; s < sim->config.streams; s++) {
+        PrefetchStream *stream = &sim->streams[s];
+        if (stream->lastPage != -1 && stream->stride != 0 && page == stream->lastPage + stream->stride) {
+            match = stream;
+            break;
+        }
+        if (stream->lastUse < oldest->lastUse) oldest = stream;
+    }
+
+    if (match == NULL) {
+        // Look for a stream close enough to take this gap as its new stride
+        for (int s = 0; s < sim->config.streams && match == NULL; s++) {
+            PrefetchStream *stream = &sim->streams[s];
+            long long gap = (long long)page - stream->lastPage;
+            if (stream->lastPage != -1 && gap != 0 && gap >= -sim->config.maxStride && gap <= sim->config.maxStride &&
+                (gap > 0 || sim->config.maxStride > 1)) {
+                match = stream;
+                match->stride = (int)gap;
+                match->confirmed = 0;
+                match->window = sim->config.minWindow;
+                match->frontier = page;
+            }
+        }
+        if (match == NULL) {
+            match = oldest;
+            match->stride = 0;
+            match->confirmed = 0;
+        }
+    } else {
+        match->confirmed++;
+    }
+
+    match->lastPage = page;
+    match->lastUse = sim->time;
+    if (match->confirmed >= 1) return readAhead(sim, match, page);
+    return 0;
+}
+
+int prefetchSimAccess(PrefetchSim *sim, int page) {
+    int wasPending = pageIndexFind(&sim->pending, page) != -1;
+    int fault = pagePolicyAccess(&sim->policy, page);
+
+    if (wasPending) {
+        if (fault) sim->wasted++;
+        else sim->useful++;
+        pageIndexRemove(&sim->pending, page);
+    }
+    sim->references++;
+    sim->faults += fault;
+    sim->time++;
+    if (trackStreams(sim, page) < 0) return -1;
+    return fault;
+}
+
+void printPrefetchStats(const PrefetchSim *sim, long long baselineFaults) {
+    long long wasted = sim->wasted + sim->pending.count; // Pages never referenced count too
+    char label[32];
+    snprintf(label, sizeof(label), "%s+ra", sim->policy.ops->name);
+    printf("%-12s %12lld %12lld %10lld %10lld %9.1f%%", label, sim->faults, sim->issued,
+           sim->useful, wasted, sim->issued > 0 ? 100.0 * sim->useful / sim->issued : 0.0);
+    if (baselineFaults > 0) {
+        printf(" %9.1f%%", 100.0 * (baselineFaults - sim->faults) / baselineFaults);
+    }
+    printf("\n");
+}
+
+void prefetchSimFree(PrefetchSim *sim) {
+    pagePolicyFree(&sim->policy);
+    pageIndexFree(&sim->pending);
+}
+
+static long long baselineFaults(const PagePolicyOps *ops, const int pages[], long long length, int frameCount) {
+    PagePolicy policy;
+    if (pagePolicyInit(&policy, ops, frameCount) < 0) return -1;
+    for (long long i = 0; i < length; i++) pagePolicyAccess(&policy, pages[i]);
+    long long faults = policy.stats.faults;
+    pagePolicyFree(&policy);
+    return faults;
+}
+
+static int comparePrefetch(const PagePolicyOps *ops, const int pages[], long long length, int frameCount,
+                           const PrefetchConfig *config) {
+    PrefetchSim sim;
+    long long baseline = baselineFaults(ops, pages, length, frameCount);
+
+    if (baseline < 0 || prefetchSimInit(&sim, ops, frameCount, config) < 0) return -1;
+    for (long long i = 0; i < length; i++) {
+        if (prefetchSimAccess(&sim, pages[i]) < 0) {
+            prefetchSimFree(&sim);
+            return -1;
+        }
+    }
+    printf("%-12s %12lld %12d %10s %10s %10s %10s\n", ops->name, baseline, 0, "-", "-", "-", "-");
+    printPrefetchStats(&sim, baseline);
+    prefetchSimFree(&sim);
+    return 0;
+}
+
+static void printPrefetchHeader() {
+    printf("%-12s %12s %12s %10s %10s %10s %10s\n", "Policy", "Faults", "Prefetched", "Useful", "Wasted",
+           "Accuracy", "Avoided");
+}
+
+int prefetchTrace(const char *path, const char *policyName, int frameCount, const PrefetchConfig *config) {
+    PageTrace trace;
+    const PagePolicyOps *ops = findPagePolicy(policyName);
+
+    if (ops == NULL) {
+        printf("Unknown policy %s\n", policyName);
+        return -1;
+    }
+    if (mapPageTrace(path, &trace) < 0) return -1;
+    printf("Trace %s: %lld references, %d frames\n", path, trace.length, frameCount);
+    printPrefetchHeader();
+    int result = comparePrefetch(ops, trace.pages, trace.length, frameCount, config);
+    unmapPageTrace(&trace);
+    return result;
+}
+
+int prefetchDemo() {
+    int length = 1000000;
+    int *pages = (int *)malloc(sizeof(int) * length);
+    int cursor[4] = {0, 0, 0, 0};
+    if (pages == NULL) return -1;
+
+    // Four interleaved file scans, one of them walking every 4th page, plus 10% random references
+    for (int i = 0; i < length; i++) {
+        int file = rand() % 4;
+        if (rand() % 10 == 0) {
+            pages[i] = rand() % 1000000;
+        } else if (file == 3) {
+            pages[i] = 3000000 + cursor[3];
+            cursor[3] = (cursor[3] + 4) % 400000;
+        } else {
+            pages[i] = 1000000 * file + cursor[file];
+            cursor[file] = (cursor[file] + 1) % 200000;
+        }
+    }
+
+    PrefetchConfig sequential = {4, 64, 8, 1};
+    PrefetchConfig strided = {4, 64, 8, 16};
+    const char *names[5] = {"fifo", "lru", "clock", "arc", "clock-pro"};
+    int result = 0;
+
+    for (int c = 0; c < 2 && result == 0; c++) {
+        printf("%s readahead, 2048 frames:\n", c == 0 ? "Sequential" : "Sequential and strided");
+        printPrefetchHeader();
+        for (int p = 0; p < 5 && result == 0; p++) {
+            result = comparePrefetch(findPagePolicy(names[p]), pages, length, 2048, c == 0 ? &sequential : &strided);
+        }
+    }
+    free(pages);
+    return result;
+}
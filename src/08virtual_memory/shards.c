@@ -0,0 +1,429 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Sampled miss-ratio curves in the style of SHARDS (Waldspurger et al.,
+    FAST '15). An exact stack-distance pass over a trace with billions of
+    references must keep every distinct page. Here a page is kept only if a hash
+    of its page number falls under a threshold. All references to a kept page
+    are kept, so a stack distance measured among the sampled pages is about
+    rate times the real one. We divide each distance by the rate, and count
+    each sampled reference as 1 / rate references.
+
+    With a page budget the sampler tracks at most maxPages pages. When a new
+    page would go over the budget, the page with the largest hash is dropped and
+    the threshold is lowered to its hash, so the rate only ever goes down.
+    Distances go into buckets of bucketFrames frames. When the bucket array
+    fills up, neighbouring buckets are merged and the width doubles, so memory
+    stays fixed however long the trace is. At the end the total is corrected to
+    the real reference count, as in SHARDS-adj.
+    Each point of the curve comes with an error bound. The sampled pages are
+    split by hash into SHARDS_GROUPS groups that each give their own curve, and
+    the spread of those curves estimates the error from which pages were
+    sampled. That error is large when a few hot pages carry most references.
+    On top of it, the scaled distances themselves are noisy, which matters
+    where the curve is steep.
+
+    The same hash filter works with any policy: miniatureMissRatio() runs a
+    policy on the sampled references with the frame count scaled by the rate.
+    That lets Clock, ARC and the others be estimated too.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+#define HASH_BITS 24
+#define HASH_SPACE (1u << HASH_BITS)
+#define MAX_BUCKETS 4096
+#define GROUP_T_95 2.131 // Student's t for a two-sided 95% interval with SHARDS_GROUPS - 1 degrees of freedom
+
+struct ShardsHeapEntry {
+    unsigned hash;
+    int page;
+};
+
+static unsigned pageHash(int page) {
+    unsigned long long x = (unsigned)page;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (unsigned)x & (HASH_SPACE - 1);
+}
+
+static double currentRate(const ShardsSampler *sampler) {
+    return (double)sampler->threshold / HASH_SPACE;
+}
+
+int shardsInit(ShardsSampler *sampler, const ShardsConfig *config) {
+    memset(sampler, 0, sizeof(*sampler));
+    if (config->rate <= 0 || config->rate > 1 || config->maxPages < 0 || config->bucketFrames < 1) {
+        printf("Invalid sampling configuration\n");
+        return -1;
+    }
+    sampler->config = *config;
+    sampler->threshold = (unsigned)(config->rate * HASH_SPACE);
+    if (sampler->threshold == 0) sampler->threshold = 1;
+    sampler->bucketFrames = config->bucketFrames;
+    sampler->buckets = (double *)calloc(MAX_BUCKETS + 1, sizeof(double));
+    sampler->groupBuckets = (double *)calloc((size_t)SHARDS_GROUPS * (MAX_BUCKETS + 1), sizeof(double));
+    if (config->maxPages > 0) {
+        sampler->heap = (struct ShardsHeapEntry *)malloc(sizeof(struct ShardsHeapEntry) * (config->maxPages + 1));
+    }
+    if (sampler->buckets == NULL || sampler->groupBuckets == NULL || (config->maxPages > 0 && sampler->heap == NULL) ||
+        stackDistanceInit(&sampler->stack) < 0) {
+        free(sampler->buckets);
+        free(sampler->groupBuckets);
+        free(sampler->heap);
+        return -1;
+    }
+    return 0;
+}
+
+static void heapPush(ShardsSampler *sampler, unsigned hash, int page) {
+    int i = sampler->heapSize++;
+    while (i > 0 && sampler->heap[(i - 1) / 2].hash < hash) {
+        sampler->heap[i] = sampler->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    sampler->heap[i].hash = hash;
+    sampler->heap[i].page = page;
+}
+
+static struct ShardsHeapEntry heapPop(ShardsSampler *sampler) {
+    struct ShardsHeapEntry top = sampler->heap[0];
+    struct ShardsHeapEntry last = sampler->heap[--sampler->heapSize];
+    int i = 0;
+    while (2 * i + 1 < sampler->heapSize) {
+        int child = 2 * i + 1;
+        if (child + 1 < sampler->heapSize && sampler->heap[child + 1].hash > sampler->heap[child].hash) child++;
+        if (sampler->heap[child].hash <= last.hash) break;
+        sampler->heap[i] = sampler->heap[child];
+        i = child;
+    }
+    if (sampler->heapSize > 0) sampler->heap[i] = last;
+    return top;
+}
+
+// Halve the resolution: buckets 2b - 1 and 2b become bucket b
+static void mergeHistogram(double *buckets) {
+    for (int b = 1; b <= MAX_BUCKETS / 2; b++) {
+        buckets[b] = buckets[2 * b - 1] + buckets[2 * b];
+    }
+    memset(buckets + MAX_BUCKETS / 2 + 1, 0, sizeof(double) * (MAX_BUCKETS / 2));
+}
+
+static void mergeBuckets(ShardsSampler *sampler) {
+    mergeHistogram(sampler->buckets);
+    for (int g = 0; g < SHARDS_GROUPS; g++) mergeHistogram(sampler->groupBuckets + (size_t)g * (MAX_BUCKETS + 1));
+    sampler->bucketCount = (sampler->bucketCount + 1) / 2;
+    sampler->bucketFrames *= 2;
+}
+
+int shardsAccess(ShardsSampler *sampler, int page) {
+    unsigned hash = pageHash(page);
+
+    sampler->references++;
+    if (hash >= sampler->threshold) return 0;
+    sampler->sampled++;
+
+    double rate = currentRate(sampler);
+    int distance = stackDistanceAccess(&sampler->stack, page);
+    if (distance < 0) return -1;
+
+    int group = hash % SHARDS_GROUPS;
+    if (distance == 0) {
+        sampler->coldMisses += 1.0 / rate;
+        sampler->groupColdMisses[group] += 1.0 / rate;
+        if (sampler->heap == NULL) return 0;
+
+        heapPush(sampler, hash, page);
+        if (sampler->heapSize > sampler->config.maxPages) {
+            // Lower the threshold to the largest hash and drop every page that had it
+            unsigned largest = sampler->heap[0].hash;
+            while (sampler->heapSize > 0 && sampler->heap[0].hash >= largest) {
+                stackDistanceForget(&sampler->stack, heapPop(sampler).page);
+            }
+            sampler->threshold = largest;
+        }
+        return 0;
+    }
+
+    double scaled = distance / rate;
+    while (scaled > (double)MAX_BUCKETS * sampler->bucketFrames) mergeBuckets(sampler);
+    int bucket = (int)ceil(scaled / sampler->bucketFrames);
+    if (bucket < 1) bucket = 1;
+    sampler->buckets[bucket] += 1.0 / rate;
+    sampler->groupBuckets[(size_t)group * (MAX_BUCKETS + 1) + bucket] += 1.0 / rate;
+    if (bucket > sampler->bucketCount) sampler->bucketCount = bucket;
+    return 0;
+}
+
+int shardsCurve(const ShardsSampler *sampler, SampledMissRatioCurve *curve) {
+    int bucketCount = sampler->bucketCount > 0 ? sampler->bucketCount : 1;
+    curve->buckets = (double *)malloc(sizeof(double) * (bucketCount + 1));
+    curve->groupBuckets = (double *)malloc(sizeof(double) * SHARDS_GROUPS * (bucketCount + 1));
+    if (curve->buckets == NULL || curve->groupBuckets == NULL) {
+        free(curve->buckets);
+        free(curve->groupBuckets);
+        return -1;
+    }
+    memcpy(curve->buckets, sampler->buckets, sizeof(double) * (bucketCount + 1));
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        memcpy(curve->groupBuckets + (size_t)g * (bucketCount + 1), sampler->groupBuckets + (size_t)g * (MAX_BUCKETS + 1),
+               sizeof(double) * (bucketCount + 1));
+    }
+    memcpy(curve->groupColdMisses, sampler->groupColdMisses, sizeof(curve->groupColdMisses));
+
+    curve->references = sampler->references;
+    curve->sampled = sampler->sampled;
+    curve->coldMisses = sampler->coldMisses;
+    curve->bucketCount = bucketCount;
+    curve->bucketFrames = sampler->bucketFrames;
+    curve->rate = currentRate(sampler);
+    curve->trackedPages = sampler->stack.lastAccess.count;
+
+    // The sample can hold more or fewer references than rate * references.
+    // The difference goes into the smallest distances, where it moves the curve least.
+    double total = curve->coldMisses;
+    for (int b = 1; b <= bucketCount; b++) total += curve->buckets[b];
+    curve->buckets[1] += curve->references - total;
+    if (curve->buckets[1] < 0) curve->buckets[1] = 0;
+    return 0;
+}
+
+void shardsFree(ShardsSampler *sampler) {
+    stackDistanceFree(&sampler->stack);
+    free(sampler->buckets);
+    free(sampler->groupBuckets);
+    free(sampler->heap);
+    sampler->buckets = sampler->groupBuckets = NULL;
+    sampler->heap = NULL;
+}
+
+// Faults at frames from a histogram, spreading a bucket evenly over its range when the size falls inside it
+static double histogramFaults(const double *buckets, int bucketCount, int bucketFrames, double coldMisses, int frames) {
+    double faults = coldMisses;
+    for (int b = bucketCount; b >= 1; b--) {
+        double low = (double)(b - 1) * bucketFrames;
+        double high = (double)b * bucketFrames;
+        if (high <= frames) break;
+        faults += low >= frames ? buckets[b] : buckets[b] * (high - frames) / bucketFrames;
+    }
+    return faults;
+}
+
+double sampledCurveMissRatio(const SampledMissRatioCurve *curve, int frames) {
+    if (curve->references == 0) return 0.0;
+    double ratio = histogramFaults(curve->buckets, curve->bucketCount, curve->bucketFrames, curve->coldMisses, frames) /
+                   curve->references;
+    return ratio > 1.0 ? 1.0 : ratio;
+}
+
+double sampledCurveErrorBound(const SampledMissRatioCurve *curve, int frames) {
+    if (curve->references == 0) return 0.0;
+
+    // Which pages were sampled: each group is a sample at rate / SHARDS_GROUPS, and the
+    // standard error of their mean is that of the whole curve
+    double sum = 0, sumSquares = 0;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        double ratio = SHARDS_GROUPS * histogramFaults(curve->groupBuckets + (size_t)g * (curve->bucketCount + 1),
+                                                       curve->bucketCount, curve->bucketFrames,
+                                                       curve->groupColdMisses[g], frames) / curve->references;
+        sum += ratio;
+        sumSquares += ratio * ratio;
+    }
+    double mean = sum / SHARDS_GROUPS;
+    double variance = (sumSquares - SHARDS_GROUPS * mean * mean) / (SHARDS_GROUPS - 1);
+    double bound = GROUP_T_95 * sqrt((variance > 0 ? variance : 0) / SHARDS_GROUPS);
+
+    // How far the scaled distances are off: a sampled distance counts the sampled pages among
+    // d distinct ones, so it is off by about sqrt(d (1 - rate) / rate). Near a cliff that moves
+    // references across the cache size, so add the largest change of the curve within that range.
+    double shift = 1.96 * sqrt(frames * (1 - curve->rate) / curve->rate);
+    if (shift < curve->bucketFrames) shift = curve->bucketFrames;
+    double here = sampledCurveMissRatio(curve, frames);
+    double below = sampledCurveMissRatio(curve, frames > shift ? (int)(frames - shift) : 0);
+    double above = sampledCurveMissRatio(curve, (int)(frames + shift));
+    bound += below - here > here - above ? below - here : here - above;
+    return bound < 1.0 ? bound : 1.0;
+}
+
+void writeSampledCurve(const SampledMissRatioCurve *curve, FILE *out) {
+    fprintf(out, "# %lld references, %lld sampled, rate %.6f, %d pages tracked\n",
+            curve->references, curve->sampled, curve->rate, curve->trackedPages);
+    fprintf(out, "# frames miss_ratio error_bound\n");
+    for (int b = 1; b <= curve->bucketCount; b++) {
+        int frames = b * curve->bucketFrames;
+        fprintf(out, "%d %.6f %.6f\n", frames, sampledCurveMissRatio(curve, frames), sampledCurveErrorBound(curve, frames));
+    }
+}
+
+void freeSampledCurve(SampledMissRatioCurve *curve) {
+    free(curve->buckets);
+    free(curve->groupBuckets);
+    curve->buckets = curve->groupBuckets = NULL;
+    curve->bucketCount = 0;
+}
+
+int shardsTrace(const char *path, const ShardsConfig *config, const char *outPath) {
+    PageTrace trace;
+    ShardsSampler sampler;
+    SampledMissRatioCurve curve;
+    int result = 0;
+
+    if (mapPageTrace(path, &trace) < 0) return -1;
+    if (shardsInit(&sampler, config) < 0) {
+        unmapPageTrace(&trace);
+        return -1;
+    }
+    for (long long i = 0; i < trace.length && result == 0; i++) {
+        result = shardsAccess(&sampler, trace.pages[i]);
+    }
+    unmapPageTrace(&trace);
+    if (result == 0) result = shardsCurve(&sampler, &curve);
+    shardsFree(&sampler);
+    if (result < 0) {
+        printf("Out of memory while sampling the trace\n");
+        return -1;
+    }
+
+    FILE *out = outPath != NULL ? fopen(outPath, "w") : stdout;
+    if (out == NULL) {
+        perror("fopen");
+        freeSampledCurve(&curve);
+        return -1;
+    }
+    writeSampledCurve(&curve, out);
+    if (out != stdout) fclose(out);
+    freeSampledCurve(&curve);
+    return 0;
+}
+
+double miniatureMissRatio(const PagePolicyOps *ops, const int pages[], long long length, int frameCount, double rate) {
+    PagePolicy policy;
+    unsigned threshold = (unsigned)(rate * HASH_SPACE);
+    int scaledFrames = (int)(frameCount * rate + 0.5);
+
+    if (scaledFrames < 1) scaledFrames = 1;
+    if (pagePolicyInit(&policy, ops, scaledFrames) < 0) return -1;
+    for (long long i = 0; i < length; i++) {
+        if (pageHash(pages[i]) < threshold) pagePolicyAccess(&policy, pages[i]);
+    }
+    // As in shardsCurve(), extra or missing sampled references are taken to be hits
+    double expected = length * ((double)threshold / HASH_SPACE);
+    double ratio = expected > 0 ? policy.stats.faults / expected : 0.0;
+    pagePolicyFree(&policy);
+    return ratio > 1.0 ? 1.0 : ratio;
+}
+
+static double secondsSince(struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int shardsDemo() {
+    int length = 4000000;
+    int pageCount = 200000;
+    int *pages = (int *)malloc(sizeof(int) * length);
+    if (pages == NULL) return -1;
+
+    // 80% of the references go to a 20000-page working set that slowly drifts, the rest anywhere
+    for (int i = 0; i < length; i++) {
+        if (rand() % 5 != 0) {
+            pages[i] = (i / 200 + rand() % 20000) % pageCount;
+        } else {
+            pages[i] = rand() % pageCount;
+        }
+    }
+
+    struct timespec start;
+    MissRatioCurve exact;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (computeMissRatioCurve(pages, length, &exact) < 0) {
+        free(pages);
+        return -1;
+    }
+    double exactTime = secondsSince(&start);
+
+    ShardsConfig configs[2] = {{0.01, 0, 64}, {0.1, 4096, 64}};
+    const char *labels[2] = {"fixed rate 0.01", "budget 4096 pages"};
+    for (int c = 0; c < 2; c++) {
+        ShardsSampler sampler;
+        SampledMissRatioCurve curve;
+        double worst = 0, total = 0, widest = 0;
+        int points = 0, outside = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (shardsInit(&sampler, &configs[c]) < 0) break;
+        for (int i = 0; i < length; i++) shardsAccess(&sampler, pages[i]);
+        int result = shardsCurve(&sampler, &curve);
+        shardsFree(&sampler);
+        double sampledTime = secondsSince(&start);
+        if (result < 0) break;
+
+        for (int frames = 1000; frames <= pageCount; frames += 1000) {
+            double error = fabs(sampledCurveMissRatio(&curve, frames) - (double)missRatioCurveFaults(&exact, frames) / length);
+            double bound = sampledCurveErrorBound(&curve, frames);
+            if (error > worst) worst = error;
+            if (bound > widest) widest = bound;
+            if (error > bound) outside++;
+            total += error;
+            points++;
+        }
+        printf("LRU, %s: final rate %.4f, %d pages tracked, %.3fs vs %.3fs exact\n", labels[c], curve.rate,
+               curve.trackedPages, sampledTime, exactTime);
+        printf("  mean error %.4f, worst %.4f; %d of %d points outside their bound, widest bound %.4f\n",
+               total / points, worst, outside, points, widest);
+        freeSampledCurve(&curve);
+    }
+
+    // Clock has no stack property, so compare a miniature simulation with the full one
+    const PagePolicyOps *clockOps = findPagePolicy("clock");
+    int sizes[3] = {5000, 20000, 50000};
+    for (int s = 0; s < 3; s++) {
+        PagePolicy policy;
+        if (pagePolicyInit(&policy, clockOps, sizes[s]) < 0) break;
+        for (int i = 0; i < length; i++) pagePolicyAccess(&policy, pages[i]);
+        double full = (double)policy.stats.faults / length;
+        pagePolicyFree(&policy);
+        printf("Clock, %d frames: full simulation %.4f, miniature at rate 0.01 %.4f\n", sizes[s], full,
+               miniatureMissRatio(clockOps, pages, length, sizes[s], 0.01));
+    }
+
+    freeMissRatioCurve(&exact);
+    free(pages);
+    return 0;
+}
@@ -0,0 +1,273 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Single-pass LRU miss-ratio curves (Mattson's stack algorithm).
+    LRU has the inclusion property: a reference hits in a cache of C frames
+    exactly when fewer than C distinct pages were used since the previous
+    reference to the same page. That count plus one is the stack distance. We
+    keep a Fenwick tree over time slots that marks the latest access of every
+    page, so the distance is a range sum taken in O(log n). One pass over the
+    trace gives a histogram of stack distances, and the faults for any number
+    of frames are the cold misses plus all references with a larger distance.
+    When the time slots run out, the live marks are renumbered from 0, which
+    keeps memory proportional to the number of distinct pages, not the trace.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+#define INITIAL_SLOTS 65536
+
+static void fenwickAdd(StackDistance *state, int slot, int delta) {
+    for (int i = slot + 1; i <= state->capacity; i += i & -i) {
+        state->tree[i] += delta;
+    }
+}
+
+// Number of marked slots in [0, slot]
+static int fenwickPrefix(const StackDistance *state, int slot) {
+    int sum = 0;
+    for (int i = slot + 1; i > 0; i -= i & -i) {
+        sum += state->tree[i];
+    }
+    return sum;
+}
+
+// Renumber the live slots 0..D-1 in time order, growing the slot space if needed
+static int compactSlots(StackDistance *state) {
+    int live = state->lastAccess.count;
+    int capacity = state->capacity;
+    while (live > capacity / 2) capacity *= 2;
+
+    if (capacity != state->capacity) {
+        int *tree = (int *)realloc(state->tree, sizeof(int) * (capacity + 1));
+        if (tree == NULL) return -1;
+        state->tree = tree;
+        int *pageAt = (int *)realloc(state->pageAt, sizeof(int) * capacity);
+        if (pageAt == NULL) return -1;
+        state->pageAt = pageAt;
+    }
+
+    int next = 0;
+    for (int slot = 0; slot < state->now; slot++) {
+        int page = state->pageAt[slot];
+        if (page != -1) {
+            state->pageAt[next] = page;
+            pageIndexInsert(&state->lastAccess, page, next);
+            next++;
+        }
+    }
+    for (int slot = next; slot < capacity; slot++) {
+        state->pageAt[slot] = -1;
+    }
+
+    // With slots 0..next-1 all marked, node i covers (i - lowbit(i), i]
+    for (int i = 1; i <= capacity; i++) {
+        int low = i - (i & -i);
+        int high = i < next ? i : next;
+        state->tree[i] = high > low ? high - low : 0;
+    }
+    state->capacity = capacity;
+    state->now = next;
+    return 0;
+}
+
+int stackDistanceInit(StackDistance *state) {
+    state->capacity = INITIAL_SLOTS;
+    state->now = 0;
+    state->tree = (int *)calloc(state->capacity + 1, sizeof(int));
+    state->pageAt = (int *)malloc(sizeof(int) * state->capacity);
+    if (state->tree == NULL || state->pageAt == NULL || pageIndexInit(&state->lastAccess, INITIAL_SLOTS) < 0) {
+        free(state->tree);
+        free(state->pageAt);
+        return -1;
+    }
+    for (int slot = 0; slot < state->capacity; slot++) state->pageAt[slot] = -1;
+    return 0;
+}
+
+int stackDistanceAccess(StackDistance *state, int page) {
+    int distance = 0;
+
+    if (state->now == state->capacity && compactSlots(state) < 0) return -1;
+
+    int last = pageIndexFind(&state->lastAccess, page);
+    if (last == -1) {
+        if (state->lastAccess.count + 1 > (int)(state->lastAccess.mask + 1) / 2 &&
+            pageIndexReserve(&state->lastAccess, 2 * (state->lastAccess.count + 1)) < 0) return -1;
+    } else {
+        distance = fenwickPrefix(state, state->now - 1) - fenwickPrefix(state, last) + 1;
+        fenwickAdd(state, last, -1);
+        state->pageAt[last] = -1;
+    }
+
+    fenwickAdd(state, state->now, 1);
+    state->pageAt[state->now] = page;
+    pageIndexInsert(&state->lastAccess, page, state->now);
+    state->now++;
+    return distance;
+}
+
+void stackDistanceForget(StackDistance *state, int page) {
+    int last = pageIndexFind(&state->lastAccess, page);
+    if (last == -1) return;
+    fenwickAdd(state, last, -1);
+    state->pageAt[last] = -1;
+    pageIndexRemove(&state->lastAccess, page);
+}
+
+void stackDistanceFree(StackDistance *state) {
+    free(state->tree);
+    free(state->pageAt);
+    pageIndexFree(&state->lastAccess);
+    state->tree = NULL;
+    state->pageAt = NULL;
+}
+
+static int recordDistance(MissRatioCurve *curve, int distance) {
+    if (distance > curve->maxDistance) {
+        int size = curve->maxDistance > 0 ? curve->maxDistance : 64;
+        while (size < distance) size *= 2;
+        long long *counts = (long long *)realloc(curve->distanceCounts, sizeof(long long) * (size + 1));
+        if (counts == NULL) return -1;
+        for (int d = curve->maxDistance + 1; d <= size; d++) counts[d] = 0;
+        curve->distanceCounts = counts;
+        curve->maxDistance = size;
+    }
+    curve->distanceCounts[distance]++;
+    return 0;
+}
+
+int computeMissRatioCurve(const int pages[], long long length, MissRatioCurve *curve) {
+    StackDistance state;
+    int result = 0;
+
+    curve->references = length;
+    curve->coldMisses = 0;
+    curve->distanceCounts = NULL;
+    curve->maxDistance = 0;
+
+    if (stackDistanceInit(&state) < 0) return -1;
+    for (long long i = 0; i < length && result == 0; i++) {
+        int distance = stackDistanceAccess(&state, pages[i]);
+        if (distance < 0) result = -1;
+        else if (distance == 0) curve->coldMisses++;
+        else result = recordDistance(curve, distance);
+    }
+
+    stackDistanceFree(&state);
+    if (result < 0) freeMissRatioCurve(curve);
+    return result;
+}
+
+long long missRatioCurveFaults(const MissRatioCurve *curve, int frames) {
+    long long faults = curve->coldMisses;
+    for (int d = frames + 1; d <= curve->maxDistance; d++) {
+        faults += curve->distanceCounts[d];
+    }
+    return faults;
+}
+
+void writeMissRatioCurve(const MissRatioCurve *curve, FILE *out) {
+    int largest = 1; // From the largest distance seen on, only cold misses remain
+    for (int d = 1; d <= curve->maxDistance; d++) {
+        if (curve->distanceCounts[d] != 0) largest = d;
+    }
+
+    // Walk from the largest size down so every row is one addition
+    long long *faults = (long long *)malloc(sizeof(long long) * (largest + 1));
+    if (faults == NULL) return;
+    faults[largest] = curve->coldMisses;
+    for (int frames = largest - 1; frames >= 1; frames--) {
+        faults[frames] = faults[frames + 1] + curve->distanceCounts[frames + 1];
+    }
+
+    fprintf(out, "# frames faults miss_ratio\n");
+    for (int frames = 1; frames <= largest; frames++) {
+        fprintf(out, "%d %lld %.6f\n", frames, faults[frames],
+                curve->references > 0 ? (double)faults[frames] / curve->references : 0.0);
+    }
+    free(faults);
+}
+
+void freeMissRatioCurve(MissRatioCurve *curve) {
+    free(curve->distanceCounts);
+    curve->distanceCounts = NULL;
+    curve->maxDistance = 0;
+}
+
+int stackDistanceTrace(const char *path, const char *outPath) {
+    PageTrace trace;
+    MissRatioCurve curve;
+
+    if (mapPageTrace(path, &trace) < 0) return -1;
+    int result = computeMissRatioCurve(trace.pages, trace.length, &curve);
+    unmapPageTrace(&trace);
+    if (result < 0) {
+        printf("Out of memory while computing the miss-ratio curve\n");
+        return -1;
+    }
+
+    FILE *out = outPath != NULL ? fopen(outPath, "w") : stdout;
+    if (out == NULL) {
+        perror("fopen");
+        freeMissRatioCurve(&curve);
+        return -1;
+    }
+    writeMissRatioCurve(&curve, out);
+    if (out != stdout) fclose(out);
+    freeMissRatioCurve(&curve);
+    return 0;
+}
+
+int stackDistanceDemo() {
+    int pages[12] = {1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5};
+    MissRatioCurve curve;
+
+    if (computeMissRatioCurve(pages, 12, &curve) < 0) return -1;
+
+    printf("LRU miss-ratio curve from one pass:\n");
+    writeMissRatioCurve(&curve, stdout);
+
+    // Cross-check against the frame-by-frame LRU simulator
+    for (int frames = 1; frames <= 5; frames++) {
+        LruSim sim;
+        int simFaults = 0;
+        if (lruSimInit(&sim, frames) < 0) break;
+        for (int i = 0; i < 12; i++) simFaults += lruSimAccess(&sim, pages[i]);
+        lruSimFree(&sim);
+        printf("%d frames: stack distance %lld faults, LRU simulation %d faults\n",
+               frames, missRatioCurveFaults(&curve, frames), simFaults);
+    }
+
+    freeMissRatioCurve(&curve);
+    return 0;
+}
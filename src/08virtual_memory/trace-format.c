@@ -0,0 +1,303 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Compact binary page trace format ("packed trace").
+    A raw trace stores every reference as a 4-byte int. Consecutive references
+    are usually close together, so we store the difference to the previous
+    page instead, zigzag-mapped to an unsigned number and written as a varint
+    (7 bits per byte, high bit set while more bytes follow). A delta of -3..3
+    then takes one byte.
+    The references are cut into blocks of a fixed number of references. Each
+    block starts again from page 0, so it can be decoded without the blocks
+    before it, and an index of block offsets at the end of the file lets
+    threads split a trace between them.
+
+    Layout, all integers little-endian:
+        header  "PTRC", u32 version, u32 references per block, u32 reserved,
+                u64 references, u64 blocks, u64 index offset      (40 bytes)
+        blocks  varint-encoded deltas
+        index   u64 file offset of every block
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "page-trace.h"
+
+#define PACKED_MAGIC "PTRC"
+#define PACKED_VERSION 1
+#define PACKED_HEADER_SIZE 40
+#define MAX_VARINT_BYTES 5 // A zigzag-mapped 32-bit delta needs at most 33 bits
+
+static void putLE(unsigned char *out, unsigned long long value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static unsigned long long getLE(const unsigned char *in, int bytes) {
+    unsigned long long value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (unsigned long long)in[i] << (8 * i);
+    }
+    return value;
+}
+
+static int flushPackedBlock(PackedTraceWriter *writer) {
+    if (writer->blockUsed == 0) return 0;
+
+    if (writer->blockCount == writer->indexCapacity) {
+        long long capacity = writer->indexCapacity > 0 ? writer->indexCapacity * 2 : 1024;
+        unsigned long long *index = (unsigned long long *)realloc(writer->index, sizeof(unsigned long long) * capacity);
+        if (index == NULL) return -1;
+        writer->index = index;
+        writer->indexCapacity = capacity;
+    }
+    writer->index[writer->blockCount++] = writer->offset;
+
+    if (fwrite(writer->buffer, 1, writer->bufferUsed, writer->file) != writer->bufferUsed) {
+        perror("fwrite");
+        return -1;
+    }
+    writer->offset += writer->bufferUsed;
+    writer->bufferUsed = 0;
+    writer->blockUsed = 0;
+    writer->previous = 0; // Every block decodes on its own
+    return 0;
+}
+
+int packedTraceWriterOpen(PackedTraceWriter *writer, const char *path, int blockRefs) {
+    unsigned char header[PACKED_HEADER_SIZE] = {0};
+
+    if (blockRefs < 1) blockRefs = PACKED_BLOCK_REFS;
+    memset(writer, 0, sizeof(*writer));
+    writer->blockRefs = blockRefs;
+    writer->buffer = (unsigned char *)malloc((size_t)blockRefs * MAX_VARINT_BYTES);
+    if (writer->buffer == NULL) return -1;
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        perror("fopen");
+        free(writer->buffer);
+        return -1;
+    }
+    // The counts are filled in by packedTraceWriterClose()
+    if (fwrite(header, 1, PACKED_HEADER_SIZE, writer->file) != PACKED_HEADER_SIZE) {
+        perror("fwrite");
+        fclose(writer->file);
+        free(writer->buffer);
+        return -1;
+    }
+    writer->offset = PACKED_HEADER_SIZE;
+    return 0;
+}
+
+int packedTraceWriterAdd(PackedTraceWriter *writer, int page) {
+    long long delta = (long long)page - writer->previous;
+    unsigned long long zigzag = delta >= 0 ? (unsigned long long)delta << 1 : ((unsigned long long)(-delta) << 1) - 1;
+    unsigned char *out = writer->buffer + writer->bufferUsed;
+
+    while (zigzag >= 0x80) {
+        *out++ = (unsigned char)(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *out++ = (unsigned char)zigzag;
+    writer->bufferUsed = out - writer->buffer;
+    writer->previous = page;
+    writer->references++;
+
+    if (++writer->blockUsed == writer->blockRefs) {
+        return flushPackedBlock(writer);
+    }
+    return 0;
+}
+
+int packedTraceWriterClose(PackedTraceWriter *writer) {
+    unsigned char header[PACKED_HEADER_SIZE] = {0};
+    int result = flushPackedBlock(writer);
+
+    if (result == 0) {
+        for (long long b = 0; b < writer->blockCount; b++) {
+            unsigned char entry[8];
+            putLE(entry, writer->index[b], 8);
+            if (fwrite(entry, 1, 8, writer->file) != 8) {
+                result = -1;
+                break;
+            }
+        }
+    }
+    if (result == 0) {
+        memcpy(header, PACKED_MAGIC, 4);
+        putLE(header + 4, PACKED_VERSION, 4);
+        putLE(header + 8, writer->blockRefs, 4);
+        putLE(header + 16, writer->references, 8);
+        putLE(header + 24, writer->blockCount, 8);
+        putLE(header + 32, writer->offset, 8);
+        if (fseek(writer->file, 0, SEEK_SET) != 0 || fwrite(header, 1, PACKED_HEADER_SIZE, writer->file) != PACKED_HEADER_SIZE) {
+            result = -1;
+        }
+    }
+    if (fclose(writer->file) != 0) result = -1;
+    if (result < 0) printf("Could not finish the packed trace\n");
+    free(writer->buffer);
+    free(writer->index);
+    writer->buffer = NULL;
+    writer->index = NULL;
+    return result;
+}
+
+int openPackedTrace(const char *path, PackedTrace *trace) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        return -1;
+    }
+    if (st.st_size < PACKED_HEADER_SIZE) {
+        printf("%s is not a packed trace\n", path);
+        close(fd);
+        return -1;
+    }
+    void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+
+    const unsigned char *data = (const unsigned char *)mapping;
+    trace->mapping = mapping;
+    trace->mappingSize = st.st_size;
+    trace->blockRefs = (int)getLE(data + 8, 4);
+    trace->references = (long long)getLE(data + 16, 8);
+    trace->blockCount = (long long)getLE(data + 24, 8);
+    unsigned long long indexOffset = getLE(data + 32, 8);
+
+    // Check the header against the file before trusting any offset in it
+    if (memcmp(data, PACKED_MAGIC, 4) != 0 || getLE(data + 4, 4) != PACKED_VERSION || trace->blockRefs < 1 ||
+        indexOffset < PACKED_HEADER_SIZE || indexOffset + 8 * (unsigned long long)trace->blockCount != (unsigned long long)st.st_size ||
+        (unsigned long long)trace->blockCount != ((unsigned long long)trace->references + trace->blockRefs - 1) / trace->blockRefs) {
+        printf("%s is not a packed trace\n", path);
+        munmap(mapping, st.st_size);
+        return -1;
+    }
+    trace->data = data;
+    trace->indexOffset = (long long)indexOffset;
+    return 0;
+}
+
+void closePackedTrace(PackedTrace *trace) {
+    if (trace->mapping != NULL) {
+        munmap(trace->mapping, trace->mappingSize);
+    }
+    trace->mapping = NULL;
+    trace->data = NULL;
+}
+
+int packedTraceBlockLength(const PackedTrace *trace, long long block) {
+    if (block == trace->blockCount - 1) {
+        return (int)(trace->references - block * trace->blockRefs);
+    }
+    return trace->blockRefs;
+}
+
+int decodePackedBlock(const PackedTrace *trace, long long block, int pages[]) {
+    const unsigned char *index = trace->data + trace->indexOffset;
+    unsigned long long start = getLE(index + 8 * block, 8);
+    unsigned long long end = block + 1 < trace->blockCount ? getLE(index + 8 * (block + 1), 8) : (unsigned long long)trace->indexOffset;
+    int length = packedTraceBlockLength(trace, block);
+    const unsigned char *in = trace->data + start;
+    const unsigned char *limit = trace->data + end;
+    long long page = 0;
+
+    if (start < PACKED_HEADER_SIZE || end > (unsigned long long)trace->indexOffset || start > end) return -1;
+
+    for (int i = 0; i < length; i++) {
+        unsigned long long zigzag = 0;
+        int shift = 0;
+        do {
+            if (in == limit || shift > 7 * (MAX_VARINT_BYTES - 1)) return -1; // Truncated or corrupt block
+            zigzag |= (unsigned long long)(*in & 0x7f) << shift;
+            shift += 7;
+        } while (*in++ & 0x80);
+
+        page += (zigzag & 1) ? -(long long)((zigzag + 1) >> 1) : (long long)(zigzag >> 1);
+        pages[i] = (int)page;
+    }
+    return length;
+}
+
+int convertTraceToPacked(const char *inPath, const char *outPath, int textInput) {
+    PackedTraceWriter writer;
+    int result = 0;
+
+    if (textInput) {
+        FILE *in = fopen(inPath, "r");
+        int page;
+        if (in == NULL) {
+            perror("fopen");
+            return -1;
+        }
+        if (packedTraceWriterOpen(&writer, outPath, PACKED_BLOCK_REFS) < 0) {
+            fclose(in);
+            return -1;
+        }
+        // Page numbers separated by white space, as printed by the demos
+        while (result == 0 && fscanf(in, "%d", &page) == 1) {
+            result = packedTraceWriterAdd(&writer, page);
+        }
+        if (result == 0 && !feof(in)) {
+            printf("%s: not a page number after %lld references\n", inPath, writer.references);
+            result = -1;
+        }
+        fclose(in);
+    } else {
+        PageTrace trace;
+        if (mapPageTrace(inPath, &trace) < 0) return -1;
+        if (packedTraceWriterOpen(&writer, outPath, PACKED_BLOCK_REFS) < 0) {
+            unmapPageTrace(&trace);
+            return -1;
+        }
+        for (long long i = 0; i < trace.length && result == 0; i++) {
+            result = packedTraceWriterAdd(&writer, trace.pages[i]);
+        }
+        unmapPageTrace(&trace);
+    }
+
+    if (packedTraceWriterClose(&writer) < 0) result = -1;
+    return result;
+}
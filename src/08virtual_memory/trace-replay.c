@@ -0,0 +1,276 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Trace replay engine. It memory-maps a page reference trace, walks it once
+    and feeds every reference to FIFO, LRU, Clock, PFF and VSWS, all sized at
+    run time. The trace is processed in blocks: each block is handed to every
+    policy in turn while it is still in cache, which lets us time each policy
+    separately without reading the trace five times. At the end it reports the
+    faults, hit ratio and references per second of every policy.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "page-policy.h"
+#include "page-trace.h"
+
+#define REPLAY_BLOCK 65536 // References handed to each policy at a time
+#define REPLAY_POLICIES 5
+#define DEMO_TRACE_LEN 1000000
+
+int mapPageTrace(const char *path, PageTrace *trace) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &st) < 0) {
+        perror("fstat");
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0 || st.st_size % sizeof(int) != 0) {
+        printf("%s is not a page trace (size %lld)\n", path, (long long)st.st_size);
+        close(fd);
+        return -1;
+    }
+
+    void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (mapping == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+    trace->pages = (const int *)mapping;
+    trace->length = st.st_size / sizeof(int);
+    trace->mapping = mapping;
+    trace->mappingSize = st.st_size;
+    return 0;
+}
+
+void unmapPageTrace(PageTrace *trace) {
+    if (trace->mapping != NULL) {
+        munmap(trace->mapping, trace->mappingSize);
+    }
+    trace->mapping = NULL;
+    trace->pages = NULL;
+    trace->length = 0;
+}
+
+int writePageTrace(const char *path, const int pages[], long long length) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    if (fwrite(pages, sizeof(int), length, file) != (size_t)length) {
+        perror("fwrite");
+        fclose(file);
+        return -1;
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+static double elapsedSeconds(struct timespec *start, struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+typedef struct {
+    FifoSim fifoSim;
+    LruHashSim lruSim;
+    ClockHashSim clockSim;
+    PffSim pffSim;
+    VswsSim vswsSim;
+    long long faults[REPLAY_POLICIES];
+    double seconds[REPLAY_POLICIES];
+    long long references;
+} ReplayState;
+
+static int initReplay(ReplayState *state, int frameCount) {
+    memset(state, 0, sizeof(*state));
+    if (frameCount < 1) {
+        printf("Frame count must be at least 1\n");
+        return -1;
+    }
+    // PFF and VSWS grow up to frameCount with the limits used by their demos
+    if (fifoSimInit(&state->fifoSim, frameCount) < 0 || lruHashSimInit(&state->lruSim, frameCount) < 0 ||
+        clockHashSimInit(&state->clockSim, frameCount) < 0 || pffSimInit(&state->pffSim, frameCount, 7, 4, 10) < 0 ||
+        vswsSimInit(&state->vswsSim, frameCount, 10, 20, 11) < 0) {
+        printf("Out of memory for %d frames\n", frameCount);
+        return -1;
+    }
+    return 0;
+}
+
+// Hand one block of references to every policy in turn
+static void replayBlock(ReplayState *state, const int block[], long long blockLen) {
+    for (int p = 0; p < REPLAY_POLICIES; p++) {
+        struct timespec t0, t1;
+        long long blockFaults = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        switch (p) {
+            case 0:
+                for (long long i = 0; i < blockLen; i++) blockFaults += fifoSimAccess(&state->fifoSim, block[i]);
+                break;
+            case 1:
+                for (long long i = 0; i < blockLen; i++) blockFaults += lruHashSimAccess(&state->lruSim, block[i]);
+                break;
+            case 2:
+                for (long long i = 0; i < blockLen; i++) blockFaults += clockHashSimAccess(&state->clockSim, block[i]);
+                break;
+            case 3:
+                for (long long i = 0; i < blockLen; i++) blockFaults += pffSimAccess(&state->pffSim, block[i]);
+                break;
+            default:
+                for (long long i = 0; i < blockLen; i++) blockFaults += vswsSimAccess(&state->vswsSim, block[i]);
+                break;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        state->faults[p] += blockFaults;
+        state->seconds[p] += elapsedSeconds(&t0, &t1);
+    }
+    state->references += blockLen;
+}
+
+static void reportReplay(const ReplayState *state, const char *path, int frameCount) {
+    const char *names[REPLAY_POLICIES] = {"FIFO", "LRU", "Clock", "PFF", "VSWS"};
+
+    printf("Trace %s: %lld references, %d frames\n", path, state->references, frameCount);
+    printf("%-8s %14s %10s %16s\n", "Policy", "Faults", "Hit ratio", "References/sec");
+    for (int p = 0; p < REPLAY_POLICIES; p++) {
+        double hitRatio = state->references > 0 ? 1.0 - (double)state->faults[p] / state->references : 0;
+        double rate = state->seconds[p] > 0 ? state->references / state->seconds[p] : 0;
+        printf("%-8s %14lld %10.4f %16.0f\n", names[p], state->faults[p], hitRatio, rate);
+    }
+}
+
+// Safe to call after a failed initReplay(): unallocated frames are NULL
+static void freeReplay(ReplayState *state) {
+    if (state->fifoSim.frames != NULL) fifoSimFree(&state->fifoSim);
+    if (state->lruSim.nodes != NULL) lruHashSimFree(&state->lruSim);
+    if (state->clockSim.frames != NULL) clockHashSimFree(&state->clockSim);
+    if (state->pffSim.frames != NULL) pffSimFree(&state->pffSim);
+    if (state->vswsSim.ws.nodes != NULL) vswsSimFree(&state->vswsSim);
+}
+
+int replayTrace(const char *path, int frameCount) {
+    ReplayState state;
+    PageTrace trace;
+
+    if (initReplay(&state, frameCount) < 0 || mapPageTrace(path, &trace) < 0) {
+        freeReplay(&state);
+        return -1;
+    }
+
+    for (long long start = 0; start < trace.length; start += REPLAY_BLOCK) {
+        long long blockLen = trace.length - start < REPLAY_BLOCK ? trace.length - start : REPLAY_BLOCK;
+        replayBlock(&state, trace.pages + start, blockLen);
+    }
+    reportReplay(&state, path, frameCount);
+
+    freeReplay(&state);
+    unmapPageTrace(&trace);
+    return 0;
+}
+
+int replayPackedTrace(const char *path, int frameCount) {
+    ReplayState state;
+    PackedTrace trace;
+    int result = 0;
+
+    if (initReplay(&state, frameCount) < 0 || openPackedTrace(path, &trace) < 0) {
+        freeReplay(&state);
+        return -1;
+    }
+
+    // Only one decoded block is held in memory at a time
+    int *block = (int *)malloc(sizeof(int) * trace.blockRefs);
+    if (block == NULL) result = -1;
+    for (long long b = 0; b < trace.blockCount && result == 0; b++) {
+        int blockLen = decodePackedBlock(&trace, b, block);
+        if (blockLen < 0) {
+            printf("%s: block %lld is corrupt\n", path, b);
+            result = -1;
+            break;
+        }
+        replayBlock(&state, block, blockLen);
+    }
+    if (result == 0) reportReplay(&state, path, frameCount);
+
+    free(block);
+    freeReplay(&state);
+    closePackedTrace(&trace);
+    return result;
+}
+
+int traceReplayDemo() {
+    const char *path = "page-trace-demo.bin";
+    int *pages = (int *)malloc(sizeof(int) * DEMO_TRACE_LEN);
+    if (pages == NULL) return -1;
+
+    // Same shape as PFFDemo(): phases with a narrow and a wider locality
+    for (int i = 0; i < DEMO_TRACE_LEN; i++) {
+        if (i % 40 < 20) {
+            pages[i] = rand() % 5;
+        } else {
+            pages[i] = rand() % 10 + 5;
+        }
+    }
+    int result = writePageTrace(path, pages, DEMO_TRACE_LEN);
+    free(pages);
+
+    if (result == 0) {
+        printf("Starting trace replay...\n");
+        result = replayTrace(path, 8);
+    }
+    if (result == 0) {
+        const char *packedPath = "page-trace-demo.ptrc";
+        struct stat raw, packed;
+
+        result = convertTraceToPacked(path, packedPath, 0);
+        if (result == 0 && stat(path, &raw) == 0 && stat(packedPath, &packed) == 0) {
+            printf("\nPacked trace: %lld bytes instead of %lld\n", (long long)packed.st_size, (long long)raw.st_size);
+            result = replayPackedTrace(packedPath, 8);
+        }
+        unlink(packedPath);
+    }
+    unlink(path);
+    return result;
+}
@@ -0,0 +1,346 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Address translation simulator. The other simulators in this chapter take
+    page numbers and only count page faults. This one takes virtual addresses
+    and also counts what it costs to translate them:
+        - a set-associative TLB with LRU, FIFO or random replacement,
+        - on a TLB miss, a page walk through a 2- to 4-level page table (one
+          memory reference per level) or through an inverted page table (one
+          reference for the hash anchor plus one per chain entry visited),
+        - on a page fault, a victim chosen by Clock over the physical frames,
+          whose page table entry and TLB entry are then invalidated.
+    The page size is a parameter, so the same addresses can be run with 4 KiB
+    and 2 MiB pages to see how much a larger TLB reach saves.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "translation-sim.h"
+
+static unsigned long long hashVpn(const TranslationSim *sim, unsigned long long vpn) {
+    return (vpn * 0x9E3779B97F4A7C15ull >> 32) % sim->config.frameCount;
+}
+
+static void freeTableNode(void **node, int level, int levels, int bits[]) {
+    if (node == NULL) return;
+    if (level < levels - 1) {
+        for (long i = 0; i < 1L << bits[level]; i++) {
+            freeTableNode((void **)node[i], level + 1, levels, bits);
+        }
+    }
+    free(node);
+}
+
+int translationSimInit(TranslationSim *sim, const TranslationConfig *config) {
+    int levels = config->levels;
+    int vpnBits = config->addressBits - config->pageShift;
+
+    memset(sim, 0, sizeof(*sim));
+    if ((levels != INVERTED_PAGE_TABLE && (levels < 2 || levels > 4)) || vpnBits < levels || config->addressBits > 63 ||
+        config->tlbSets < 1 || (config->tlbSets & (config->tlbSets - 1)) != 0 || config->tlbWays < 1 ||
+        config->frameCount < 1) {
+        printf("Invalid translation configuration\n");
+        return -1;
+    }
+    sim->config = *config;
+
+    sim->tlb = (TlbEntry *)calloc((size_t)config->tlbSets * config->tlbWays, sizeof(TlbEntry));
+    sim->frames = (PhysicalFrame *)calloc(config->frameCount, sizeof(PhysicalFrame));
+    if (sim->tlb == NULL || sim->frames == NULL) goto fail;
+
+    if (levels == INVERTED_PAGE_TABLE) {
+        sim->hashAnchor = (int *)malloc(sizeof(int) * config->frameCount);
+        sim->hashNext = (int *)malloc(sizeof(int) * config->frameCount);
+        if (sim->hashAnchor == NULL || sim->hashNext == NULL) goto fail;
+        for (int i = 0; i < config->frameCount; i++) sim->hashAnchor[i] = -1;
+    } else {
+        // Split the page number evenly, giving any extra bits to the top levels
+        int shift = vpnBits;
+        for (int l = 0; l < levels; l++) {
+            sim->levelBits[l] = vpnBits / levels + (l < vpnBits % levels ? 1 : 0);
+            shift -= sim->levelBits[l];
+            sim->levelShift[l] = shift;
+        }
+        sim->root = (void **)calloc(1L << sim->levelBits[0], levels > 1 ? sizeof(void *) : sizeof(int));
+        if (sim->root == NULL) goto fail;
+    }
+    return 0;
+
+fail:
+    printf("Out of memory for the translation simulator\n");
+    translationSimFree(sim);
+    return -1;
+}
+
+// Walk the page table. Returns the frame, or -1 if the page is not resident.
+static int walkPageTable(TranslationSim *sim, unsigned long long vpn) {
+    if (sim->config.levels == INVERTED_PAGE_TABLE) {
+        sim->walkReferences++; // Hash anchor table
+        for (int f = sim->hashAnchor[hashVpn(sim, vpn)]; f != -1; f = sim->hashNext[f]) {
+            sim->walkReferences++; // One inverted page table entry
+            if (sim->frames[f].vpn == vpn) return f;
+        }
+        return -1;
+    }
+
+    void **node = sim->root;
+    int last = sim->config.levels - 1;
+    for (int l = 0; l < last; l++) {
+        sim->walkReferences++;
+        node = (void **)node[(vpn >> sim->levelShift[l]) & ((1ull << sim->levelBits[l]) - 1)];
+        if (node == NULL) return -1;
+    }
+    sim->walkReferences++;
+    return ((int *)node)[(vpn >> sim->levelShift[last]) & ((1ull << sim->levelBits[last]) - 1)] - 1;
+}
+
+// Point the page table entry of vpn at frame + 1 (0 clears it). Returns -1 if out of memory.
+static int setPageTableEntry(TranslationSim *sim, unsigned long long vpn, int value) {
+    void **node = sim->root;
+    int last = sim->config.levels - 1;
+
+    for (int l = 0; l < last; l++) {
+        void **slot = &node[(vpn >> sim->levelShift[l]) & ((1ull << sim->levelBits[l]) - 1)];
+        if (*slot == NULL) {
+            if (value == 0) return 0; // Nothing mapped below here
+            *slot = calloc(1L << sim->levelBits[l + 1], l + 1 < last ? sizeof(void *) : sizeof(int));
+            if (*slot == NULL) return -1;
+        }
+        node = (void **)*slot;
+    }
+    ((int *)node)[(vpn >> sim->levelShift[last]) & ((1ull << sim->levelBits[last]) - 1)] = value;
+    return 0;
+}
+
+static void unmapFrame(TranslationSim *sim, int frame) {
+    unsigned long long vpn = sim->frames[frame].vpn;
+
+    if (sim->config.levels == INVERTED_PAGE_TABLE) {
+        int *link = &sim->hashAnchor[hashVpn(sim, vpn)];
+        while (*link != frame) link = &sim->hashNext[*link];
+        *link = sim->hashNext[frame];
+    } else {
+        setPageTableEntry(sim, vpn, 0);
+    }
+
+    // TLB shootdown
+    TlbEntry *set = &sim->tlb[(vpn & (sim->config.tlbSets - 1)) * sim->config.tlbWays];
+    for (int w = 0; w < sim->config.tlbWays; w++) {
+        if (set[w].valid && set[w].vpn == vpn) set[w].valid = 0;
+    }
+}
+
+static int handlePageFault(TranslationSim *sim, unsigned long long vpn) {
+    int frame;
+
+    sim->pageFaults++;
+    if (sim->usedFrames < sim->config.frameCount) {
+        frame = sim->usedFrames++;
+    } else {
+        while (sim->frames[sim->pointer].useBit == 1) {
+            sim->frames[sim->pointer].useBit = 0;
+            sim->pointer = (sim->pointer + 1) % sim->config.frameCount;
+        }
+        frame = sim->pointer;
+        sim->pointer = (sim->pointer + 1) % sim->config.frameCount;
+        unmapFrame(sim, frame);
+    }
+
+    sim->frames[frame].vpn = vpn;
+    sim->frames[frame].inUse = 1;
+    if (sim->config.levels == INVERTED_PAGE_TABLE) {
+        unsigned long long h = hashVpn(sim, vpn);
+        sim->hashNext[frame] = sim->hashAnchor[h];
+        sim->hashAnchor[h] = frame;
+    } else if (setPageTableEntry(sim, vpn, frame + 1) < 0) {
+        return -1;
+    }
+    return frame;
+}
+
+unsigned long long translateAddress(TranslationSim *sim, unsigned long long address) {
+    unsigned long long vpn = (address >> sim->config.pageShift) & ((1ull << (sim->config.addressBits - sim->config.pageShift)) - 1);
+    unsigned long long offset = address & ((1ull << sim->config.pageShift) - 1);
+    TlbEntry *set = &sim->tlb[(vpn & (sim->config.tlbSets - 1)) * sim->config.tlbWays];
+    int ways = sim->config.tlbWays;
+    int frame = -1;
+
+    sim->references++;
+    sim->time++;
+    for (int w = 0; w < ways; w++) {
+        if (set[w].valid && set[w].vpn == vpn) {
+            sim->tlbHits++;
+            if (sim->config.tlbPolicy == TLB_LRU) set[w].stamp = sim->time;
+            frame = set[w].frame;
+            break;
+        }
+    }
+
+    if (frame == -1) {
+        frame = walkPageTable(sim, vpn);
+        if (frame == -1) {
+            frame = handlePageFault(sim, vpn);
+            if (frame < 0) {
+                printf("Out of memory for page tables\n");
+                return 0;
+            }
+        }
+
+        // Fill the TLB: an empty way if there is one, otherwise the policy's victim
+        int victim = -1;
+        for (int w = 0; w < ways && victim == -1; w++) {
+            if (!set[w].valid) victim = w;
+        }
+        if (victim == -1) {
+            if (sim->config.tlbPolicy == TLB_RANDOM) {
+                victim = rand() % ways;
+            } else {
+                victim = 0;
+                for (int w = 1; w < ways; w++) {
+                    if (set[w].stamp < set[victim].stamp) victim = w;
+                }
+            }
+        }
+        set[victim].vpn = vpn;
+        set[victim].frame = frame;
+        set[victim].valid = 1;
+        set[victim].stamp = sim->time;
+    }
+
+    sim->frames[frame].useBit = 1;
+    return ((unsigned long long)frame << sim->config.pageShift) | offset;
+}
+
+void printTranslationStats(const TranslationSim *sim, const char *label) {
+    double references = sim->references > 0 ? (double)sim->references : 1.0;
+    unsigned long long reach = (unsigned long long)sim->config.tlbSets * sim->config.tlbWays << sim->config.pageShift;
+
+    printf("%-26s TLB hit rate %.4f, walk refs/ref %.4f, faults/ref %.6f, TLB reach %llu KiB\n",
+           label, sim->tlbHits / references, sim->walkReferences / references,
+           sim->pageFaults / references, reach >> 10);
+}
+
+void translationSimFree(TranslationSim *sim) {
+    if (sim->root != NULL) {
+        freeTableNode(sim->root, 0, sim->config.levels, sim->levelBits);
+    }
+    free(sim->hashAnchor);
+    free(sim->hashNext);
+    free(sim->tlb);
+    free(sim->frames);
+    sim->root = NULL;
+    sim->hashAnchor = sim->hashNext = NULL;
+    sim->tlb = NULL;
+    sim->frames = NULL;
+}
+
+int replayAddressTrace(const char *path, const TranslationConfig *config) {
+    TranslationSim sim;
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &st) < 0 || st.st_size == 0 || st.st_size % sizeof(unsigned long long) != 0) {
+        printf("%s is not an address trace\n", path);
+        close(fd);
+        return -1;
+    }
+    const unsigned long long *addresses = (const unsigned long long *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addresses == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    if (translationSimInit(&sim, config) < 0) {
+        munmap((void *)addresses, st.st_size);
+        return -1;
+    }
+
+    long long count = st.st_size / sizeof(unsigned long long);
+    for (long long i = 0; i < count; i++) {
+        translateAddress(&sim, addresses[i]);
+    }
+    printTranslationStats(&sim, path);
+
+    translationSimFree(&sim);
+    munmap((void *)addresses, st.st_size);
+    return 0;
+}
+
+int translationDemo() {
+    const int count = 2000000;
+    unsigned long long *addresses = (unsigned long long *)malloc(sizeof(unsigned long long) * count);
+    unsigned long long scanBase = 0x7f0000000000ull; // 512 MiB array scanned in 64-byte steps
+    unsigned long long hotBase = 0x550000000000ull; // 16 MiB of hot data touched at random
+    unsigned long long scan = 0;
+
+    if (addresses == NULL) return -1;
+    for (int i = 0; i < count; i++) {
+        if (i % 4 == 0) {
+            addresses[i] = scanBase + scan;
+            scan = (scan + 64) % (512ull << 20);
+        } else {
+            addresses[i] = hotBase + (((unsigned long long)rand() << 8) ^ rand()) % (16ull << 20);
+        }
+    }
+
+    // 256 MiB of physical memory and a 64-entry, 4-way TLB in every case
+    TranslationConfig configs[] = {
+        {4, 12, 48, 16, 4, TLB_LRU, 65536},
+        {2, 12, 48, 16, 4, TLB_LRU, 65536},
+        {INVERTED_PAGE_TABLE, 12, 48, 16, 4, TLB_LRU, 65536},
+        {4, 12, 48, 16, 4, TLB_FIFO, 65536},
+        {3, 21, 48, 16, 4, TLB_LRU, 128},
+    };
+    const char *labels[] = {"4 KiB, 4-level, LRU TLB", "4 KiB, 2-level, LRU TLB", "4 KiB, inverted, LRU TLB",
+                            "4 KiB, 4-level, FIFO TLB", "2 MiB, 3-level, LRU TLB"};
+
+    printf("Address translation simulation, %d references\n", count);
+    for (int c = 0; c < 5; c++) {
+        TranslationSim sim;
+        if (translationSimInit(&sim, &configs[c]) < 0) break;
+        for (int i = 0; i < count; i++) {
+            translateAddress(&sim, addresses[i]);
+        }
+        printTranslationStats(&sim, labels[c]);
+        translationSimFree(&sim);
+    }
+
+    free(addresses);
+    return 0;
+}
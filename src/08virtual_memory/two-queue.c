@@ -0,0 +1,154 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    2Q replacement (Johnson and Shasha, 1994), the full version.
+    A page seen for the first time goes into A1in, a small FIFO queue. If it
+    is not used again before it falls out of A1in, it is dropped, and only its
+    number is remembered in A1out, a FIFO ghost queue. A page referenced again
+    while in A1out has proved it is reused and is loaded into Am, an LRU list.
+    Pages of a sequential scan pass through A1in once and never reach Am, so
+    the scan cannot flush the pages that are used over and over.
+    A1in gets a quarter of the frames and A1out remembers half as many pages
+    as there are frames, the sizes suggested in the paper.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include "page-policy.h"
+
+#define TWOQ_A1IN 1
+#define TWOQ_A1OUT 2
+#define TWOQ_AM 3
+#define TWOQ_PREFETCHED 1 // Read ahead and not referenced yet
+
+// Free a frame: from A1in if it is over its share, otherwise the LRU page of Am
+static int twoQueueReclaim(TwoQueueSim *sim) {
+    int node;
+    if (sim->a1in.size > sim->kin || sim->am.size == 0) {
+        node = sim->a1in.tail;
+        pageListRemove(&sim->pool, &sim->a1in, node);
+        if (sim->pool.nodes[node].flags & TWOQ_PREFETCHED) {
+            // Never referenced: a ghost would make its first reference look like a reuse
+            int page = sim->pool.nodes[node].page;
+            nodePoolRelease(&sim->pool, node);
+            return page;
+        }
+        sim->pool.nodes[node].list = TWOQ_A1OUT;
+        pageListPushHead(&sim->pool, &sim->a1out, node);
+        if (sim->a1out.size > sim->kout) {
+            int oldest = sim->a1out.tail;
+            pageListRemove(&sim->pool, &sim->a1out, oldest);
+            nodePoolRelease(&sim->pool, oldest);
+        }
+        return sim->pool.nodes[node].page;
+    }
+    node = sim->am.tail;
+    int page = sim->pool.nodes[node].page;
+    pageListRemove(&sim->pool, &sim->am, node);
+    nodePoolRelease(&sim->pool, node);
+    return page;
+}
+
+int twoQueueSimInit(TwoQueueSim *sim, int frameCount) {
+    sim->kin = frameCount / 4 > 0 ? frameCount / 4 : 1;
+    sim->kout = frameCount / 2 > 0 ? frameCount / 2 : 1;
+    if (nodePoolInit(&sim->pool, frameCount + sim->kout + 1) < 0) return -1;
+    pageListInit(&sim->a1in);
+    pageListInit(&sim->a1out);
+    pageListInit(&sim->am);
+    sim->frameCount = frameCount;
+    return 0;
+}
+
+int twoQueueSimAccess(TwoQueueSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    int list = node != -1 ? sim->pool.nodes[node].list : 0;
+
+    if (list == TWOQ_AM) {
+        pageListRemove(&sim->pool, &sim->am, node);
+        pageListPushHead(&sim->pool, &sim->am, node);
+        return 0;
+    }
+    if (list == TWOQ_A1IN) {
+        if (sim->pool.nodes[node].flags & TWOQ_PREFETCHED) {
+            // The first reference to a prefetched page starts its stay in A1in
+            sim->pool.nodes[node].flags = 0;
+            pageListRemove(&sim->pool, &sim->a1in, node);
+            pageListPushHead(&sim->pool, &sim->a1in, node);
+        }
+        return 0; // Correlated references while in A1in do not count as reuse
+    }
+
+    if (sim->a1in.size + sim->am.size == sim->frameCount) {
+        twoQueueReclaim(sim);
+        // The reclaim may have dropped this very page from A1out
+        node = pageIndexFind(&sim->pool.index, page);
+        list = node != -1 ? sim->pool.nodes[node].list : 0;
+    }
+    if (list == TWOQ_A1OUT) {
+        pageListRemove(&sim->pool, &sim->a1out, node);
+        sim->pool.nodes[node].list = TWOQ_AM;
+        pageListPushHead(&sim->pool, &sim->am, node);
+    } else {
+        node = nodePoolAlloc(&sim->pool, page);
+        sim->pool.nodes[node].list = TWOQ_A1IN;
+        pageListPushHead(&sim->pool, &sim->a1in, node);
+    }
+    return 1;
+}
+
+// Load a page ahead of use into A1in. A ghost in A1out is forgotten rather
+// than promoted to Am, since a prefetch is not a reuse.
+int twoQueueSimPrefetch(TwoQueueSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    if (node != -1) {
+        if (sim->pool.nodes[node].list != TWOQ_A1OUT) return 0;
+        pageListRemove(&sim->pool, &sim->a1out, node);
+        nodePoolRelease(&sim->pool, node);
+    }
+    if (sim->a1in.size + sim->am.size == sim->frameCount) twoQueueReclaim(sim);
+    node = nodePoolAlloc(&sim->pool, page);
+    sim->pool.nodes[node].list = TWOQ_A1IN;
+    sim->pool.nodes[node].flags = TWOQ_PREFETCHED;
+    pageListPushHead(&sim->pool, &sim->a1in, node);
+    return 1;
+}
+
+int twoQueueSimEvict(TwoQueueSim *sim) {
+    if (sim->a1in.size + sim->am.size == 0) return -1;
+    return twoQueueReclaim(sim);
+}
+
+int twoQueueSimContains(const TwoQueueSim *sim, int page) {
+    int node = pageIndexFind(&sim->pool.index, page);
+    return node != -1 && (sim->pool.nodes[node].list == TWOQ_A1IN || sim->pool.nodes[node].list == TWOQ_AM);
+}
+
+void twoQueueSimFree(TwoQueueSim *sim) {
+    nodePoolFree(&sim->pool);
+}
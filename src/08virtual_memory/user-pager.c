@@ -0,0 +1,315 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    User-space demand pager. The Clock code in clock.c only moves integers
+    around; this file runs the same algorithm on real memory. A region is
+    mapped with no access rights, and the pager catches the SIGSEGV (SIGBUS on
+    macOS) of every access it needs to see:
+        - the first touch of a page: if frameCount pages are already resident,
+          Clock picks a victim, which is written back with msync() if it was
+          modified and released with madvise(MADV_DONTNEED); the new page is
+          then made readable and the kernel reads it in from the backing file,
+        - the first write to a page: it is made writable and marked modified,
+        - a touch after the hand cleared the use bit. The hardware use bit is
+          not visible from user space, so the hand clears the bit by removing
+          the page's access rights, and the next touch sets it again.
+    The region is backed by a file, or by an unlinked temporary file that acts
+    as swap for an anonymous region, so the resident set stays bounded however
+    large the data is. Faults are handled on the faulting thread without
+    locks, so a region should be used by one thread at a time.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "user-pager.h"
+
+static UserPager *registeredPagers[USER_PAGER_MAX];
+static struct sigaction previousSegv;
+static struct sigaction previousBus;
+static int handlerInstalled = 0;
+
+static char *pageAddress(const UserPager *pager, int page) {
+    return pager->base + (size_t)page * pager->pageSize;
+}
+
+static int evictPage(UserPager *pager, int frame) {
+    int page = pager->frames[frame].pageNumber;
+    char *address = pageAddress(pager, page);
+
+    if (pager->frames[frame].modifiedBit) {
+        if (msync(address, pager->pageSize, MS_SYNC) < 0) return -1;
+        pager->writebacks++;
+    }
+    if (mprotect(address, pager->pageSize, PROT_NONE) < 0 ||
+        madvise(address, pager->pageSize, MADV_DONTNEED) < 0) return -1;
+    pager->frameOf[page] = -1;
+    pager->evictions++;
+    return 0;
+}
+
+// Runs inside the signal handler, so it only makes system calls
+static int handlePagerFault(UserPager *pager, int page) {
+    int frame = pager->frameOf[page];
+    Frame *frames = pager->frames;
+
+    if (frame != -1) {
+        if (frames[frame].useBit == 0) {
+            // The hand cleared the use bit by taking the access rights away
+            frames[frame].useBit = 1;
+            pager->referenceFaults++;
+            return mprotect(pageAddress(pager, page), pager->pageSize,
+                            frames[frame].modifiedBit ? PROT_READ | PROT_WRITE : PROT_READ);
+        }
+        if (frames[frame].modifiedBit) return -1; // Already writable, so not a fault the pager made
+        frames[frame].modifiedBit = 1;
+        pager->writeFaults++;
+        return mprotect(pageAddress(pager, page), pager->pageSize, PROT_READ | PROT_WRITE);
+    }
+
+    pager->pageFaults++;
+    if (pager->usedFrames < pager->frameCount) {
+        frame = pager->usedFrames++;
+    } else {
+        // Same sweep as clockHashSimAccess
+        while (frames[pager->pointer].useBit == 1) {
+            frames[pager->pointer].useBit = 0;
+            if (mprotect(pageAddress(pager, frames[pager->pointer].pageNumber), pager->pageSize, PROT_NONE) < 0) {
+                return -1;
+            }
+            pager->pointer = (pager->pointer + 1) % pager->frameCount;
+        }
+        frame = pager->pointer;
+        if (evictPage(pager, frame) < 0) return -1;
+        pager->pointer = (pager->pointer + 1) % pager->frameCount;
+    }
+
+    // Readable first; a write faults once more and makes the page writable
+    frames[frame].pageNumber = page;
+    frames[frame].useBit = 1;
+    frames[frame].modifiedBit = 0;
+    pager->frameOf[page] = frame;
+    return mprotect(pageAddress(pager, page), pager->pageSize, PROT_READ);
+}
+
+// Put back the handlers that were there before the first pager was opened
+static void restoreFaultHandlers() {
+    sigaction(SIGSEGV, &previousSegv, NULL);
+    sigaction(SIGBUS, &previousBus, NULL);
+    handlerInstalled = 0;
+}
+
+static void pagerFaultHandler(int sig, siginfo_t *info, void *context) {
+    (void)sig;
+    (void)context;
+    char *address = (char *)info->si_addr;
+
+    for (int i = 0; i < USER_PAGER_MAX; i++) {
+        UserPager *pager = registeredPagers[i];
+        if (pager != NULL && address >= pager->base && address < pager->base + pager->length) {
+            if (handlePagerFault(pager, (int)((size_t)(address - pager->base) / pager->pageSize)) == 0) return;
+            break;
+        }
+    }
+    // Not a pager fault: put the previous handlers back, and the retried access reaches them.
+    // Both signals are restored so a later registerPager does not save our own handler as previous.
+    restoreFaultHandlers();
+}
+
+static int registerPager(UserPager *pager) {
+    int slot = -1;
+    for (int i = 0; i < USER_PAGER_MAX && slot == -1; i++) {
+        if (registeredPagers[i] == NULL) slot = i;
+    }
+    if (slot == -1) {
+        printf("At most %d regions can be paged at once\n", USER_PAGER_MAX);
+        return -1;
+    }
+
+    if (!handlerInstalled) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = pagerFaultHandler;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGSEGV, &action, &previousSegv) < 0 || sigaction(SIGBUS, &action, &previousBus) < 0) {
+            perror("sigaction");
+            return -1;
+        }
+        handlerInstalled = 1;
+    }
+    registeredPagers[slot] = pager;
+    return 0;
+}
+
+int userPagerOpen(UserPager *pager, const char *path, size_t length, int frameCount) {
+    struct stat st;
+
+    memset(pager, 0, sizeof(*pager));
+    pager->fd = -1;
+    pager->pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    pager->length = (length + pager->pageSize - 1) / pager->pageSize * pager->pageSize;
+    if (length == 0 || frameCount < 1 || pager->length / pager->pageSize > INT_MAX) {
+        printf("Invalid user pager configuration\n");
+        return -1;
+    }
+    pager->pageCount = (int)(pager->length / pager->pageSize);
+    pager->frameCount = frameCount < pager->pageCount ? frameCount : pager->pageCount;
+
+    if (path != NULL) {
+        pager->fd = open(path, O_RDWR | O_CREAT, 0644);
+    } else {
+        char name[] = "/tmp/user-pager-XXXXXX";
+        pager->fd = mkstemp(name);
+        if (pager->fd >= 0) unlink(name);
+    }
+    if (pager->fd < 0) {
+        perror("open");
+        return -1;
+    }
+    if (fstat(pager->fd, &st) < 0 || ((size_t)st.st_size < pager->length && ftruncate(pager->fd, (off_t)pager->length) < 0)) {
+        perror("ftruncate");
+        close(pager->fd);
+        return -1;
+    }
+
+    pager->base = (char *)mmap(NULL, pager->length, PROT_NONE, MAP_SHARED, pager->fd, 0);
+    if (pager->base == MAP_FAILED) {
+        perror("mmap");
+        close(pager->fd);
+        return -1;
+    }
+    pager->frames = (Frame *)malloc(sizeof(Frame) * pager->frameCount);
+    pager->frameOf = (int *)malloc(sizeof(int) * pager->pageCount);
+    if (pager->frames == NULL || pager->frameOf == NULL || registerPager(pager) < 0) {
+        free(pager->frames);
+        free(pager->frameOf);
+        munmap(pager->base, pager->length);
+        close(pager->fd);
+        return -1;
+    }
+    for (int i = 0; i < pager->frameCount; i++) {
+        pager->frames[i].pageNumber = -1;
+        pager->frames[i].useBit = 0;
+        pager->frames[i].modifiedBit = 0;
+    }
+    for (int i = 0; i < pager->pageCount; i++) pager->frameOf[i] = -1;
+    return 0;
+}
+
+int userPagerSync(UserPager *pager) {
+    for (int f = 0; f < pager->usedFrames; f++) {
+        Frame *frame = &pager->frames[f];
+        if (!frame->modifiedBit) continue;
+
+        // Write-protect first so a later write marks the page modified again
+        char *address = pageAddress(pager, frame->pageNumber);
+        if (mprotect(address, pager->pageSize, frame->useBit ? PROT_READ : PROT_NONE) < 0 ||
+            msync(address, pager->pageSize, MS_SYNC) < 0) {
+            perror("msync");
+            return -1;
+        }
+        frame->modifiedBit = 0;
+        pager->writebacks++;
+    }
+    return 0;
+}
+
+int userPagerClose(UserPager *pager) {
+    int status = userPagerSync(pager);
+    int remaining = 0;
+
+    for (int i = 0; i < USER_PAGER_MAX; i++) {
+        if (registeredPagers[i] == pager) registeredPagers[i] = NULL;
+        if (registeredPagers[i] != NULL) remaining++;
+    }
+    if (remaining == 0 && handlerInstalled) restoreFaultHandlers();
+    munmap(pager->base, pager->length);
+    close(pager->fd);
+    free(pager->frames);
+    free(pager->frameOf);
+    pager->base = NULL;
+    pager->frames = NULL;
+    pager->frameOf = NULL;
+    return status;
+}
+
+void printUserPagerStats(const UserPager *pager, const char *label) {
+    printf("%-24s %d of %d pages resident at most, page faults %lld, reference faults %lld, "
+           "write faults %lld, evictions %lld, writebacks %lld\n",
+           label, pager->frameCount, pager->pageCount, pager->pageFaults, pager->referenceFaults,
+           pager->writeFaults, pager->evictions, pager->writebacks);
+}
+
+int userPagerDemo() {
+    const int references = 200000;
+    UserPager pager;
+    ClockHashSim sim;
+    long long simFaults = 0;
+    long long mismatches = 0;
+    struct timespec start, end;
+
+    // 64 MiB anonymous region, 4 MiB resident
+    if (userPagerOpen(&pager, NULL, 64u << 20, (int)((4u << 20) / sysconf(_SC_PAGESIZE))) < 0) return -1;
+    if (clockHashSimInit(&sim, pager.frameCount) < 0) {
+        userPagerClose(&pager);
+        return -1;
+    }
+    int hotPages = pager.frameCount * 3 / 4;
+
+    // Write each page's number into it, then read pages back, mostly from a hot set
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int page = 0; page < pager.pageCount; page++) {
+        *(int *)(pager.base + (size_t)page * pager.pageSize) = page;
+        simFaults += clockHashSimAccess(&sim, page);
+    }
+    for (int i = 0; i < references; i++) {
+        int page = rand() % 5 == 0 ? rand() % pager.pageCount : rand() % hotPages * 7 % pager.pageCount;
+        if (*(volatile int *)(pager.base + (size_t)page * pager.pageSize) != page) mismatches++;
+        simFaults += clockHashSimAccess(&sim, page);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("User-space pager, %d writes then %d reads\n", pager.pageCount, references);
+    printUserPagerStats(&pager, "Clock pager");
+    printf("%-24s page faults %lld (%s), data errors %lld, %.2f us per fault of any kind\n",
+           "ClockHashSim", simFaults, simFaults == pager.pageFaults ? "same" : "different", mismatches,
+           seconds * 1e6 / (pager.pageFaults + pager.referenceFaults + pager.writeFaults));
+
+    clockHashSimFree(&sim);
+    return userPagerClose(&pager);
+}
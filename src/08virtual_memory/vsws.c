@@ -33,72 +33,26 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "page-policy.h"
 
 #define MAX_PAGES 400
 #define MAX_FRAMES 20
 
-typedef struct {
-    int pageNumber;
-    int useBit;
-} Frame;
-
-void initializeFramesVSWS(Frame frames[], int size) {
-    for (int i = 0; i < size; i++) {
-        frames[i].pageNumber = -1; // Indicates an empty frame
-        frames[i].useBit = 0;
-    }
-}
-
-int findPage(int pageNumber, Frame frames[], int size) {
-    for (int i = 0; i < size; i++) {
-        if (frames[i].pageNumber == pageNumber) {
-            return i; // Page found
-        }
-    }
-    return -1; // Page not found
-}
-
+// Replay the demo trace through the VSWS engine and report every sample
 void simulateVSWS(int pages[], int M, int L, int Q) {
-    Frame frames[MAX_FRAMES];
-    initializeFramesVSWS(frames, MAX_FRAMES);
-
-    int frameCount = 0;
+    VswsSim sim;
     int pageFaults = 0;
-    int lastSampleTime = 0;
-    int currentTime = 0;
-
-    for (currentTime = 0; currentTime < MAX_PAGES; currentTime++) {
-        int pageIndex = findPage(pages[currentTime], frames, frameCount);
-
-        if (pageIndex == -1) { // Page fault
-            pageFaults++;
-            if (frameCount < MAX_FRAMES) {
-                frames[frameCount].pageNumber = pages[currentTime];
-                frames[frameCount].useBit = 1;
-                frameCount++;
-            }
-        } else {
-            frames[pageIndex].useBit = 1; // Mark the page as used
-        }
 
-        // Check the VSWS policy conditions
-        if ((currentTime - lastSampleTime == L) || (pageFaults == Q)) {
-            // Scan use bits and adjust the resident set
-            for (int i = 0; i < frameCount; i++) {
-                if (frames[i].useBit == 0) {
-                    frames[i] = frames[--frameCount]; // Remove the page
-                    i--; // Adjust loop index after removal
-                } else {
-                    frames[i].useBit = 0; // Reset the use bit for the next interval
-                }
-            }
-
-
-            printf("Sample at time %d, resident set size: %d\n", currentTime, frameCount);
-            lastSampleTime = currentTime;
-            pageFaults = 0; // Reset page faults for the next interval
+    if (vswsSimInit(&sim, MAX_FRAMES, M, L, Q) < 0) return;
+    for (int currentTime = 0; currentTime < MAX_PAGES; currentTime++) {
+        long long samples = sim.samples;
+        pageFaults += vswsSimAccess(&sim, pages[currentTime]);
+        if (sim.samples != samples) {
+            printf("Sample at time %d, resident set size: %d\n", currentTime, sim.ws.size);
         }
     }
+    printf("Total page faults: %d\n", pageFaults);
+    vswsSimFree(&sim);
 }
 
 int VSWSDemo() {
@@ -117,3 +71,48 @@ int VSWSDemo() {
 
     return 0;
 }
+
+// Step-by-step VSWS with run-time parameters, used by simulateVSWS() and the trace replay engine.
+// A sample is taken after L references, or after Q faults once at least M references have passed.
+int vswsSimInit(VswsSim *sim, int maxFrames, int M, int L, int Q) {
+    if (maxFrames < 1 || L < 1) {
+        printf("VSWS needs at least one frame and L >= 1\n");
+        sim->ws.nodes = NULL;
+        return -1;
+    }
+    // The set never holds more than maxFrames pages, so its nodes never need to grow
+    if (workingSetInit(&sim->ws, maxFrames, 0) < 0) return -1;
+    sim->maxFrames = maxFrames;
+    sim->M = M;
+    sim->L = L;
+    sim->Q = Q;
+    sim->intervalFaults = 0;
+    sim->samples = 0;
+    sim->lastSampleTime = 0;
+    return 0;
+}
+
+int vswsSimAccess(VswsSim *sim, int page) {
+    int fault = !workingSetContains(&sim->ws, page);
+
+    if (fault) {
+        sim->intervalFaults++;
+        // A full resident set gives up its least recently used page
+        if (sim->ws.size == sim->maxFrames) workingSetEvictOldest(&sim->ws);
+    }
+    workingSetAccess(&sim->ws, page);
+
+    long long elapsed = sim->ws.now - sim->lastSampleTime;
+    if (elapsed >= sim->L || (sim->intervalFaults >= sim->Q && elapsed >= sim->M)) {
+        // Keep only the pages referenced during the interval
+        workingSetTrim(&sim->ws, sim->lastSampleTime);
+        sim->lastSampleTime = sim->ws.now;
+        sim->intervalFaults = 0;
+        sim->samples++;
+    }
+    return fault;
+}
+
+void vswsSimFree(VswsSim *sim) {
+    workingSetFree(&sim->ws);
+}
@@ -0,0 +1,197 @@
+/*
+    Name: Dr. Qixin Deng
+    Date: October 17, 2026
+    Description:
+    Denning's working set WS(t, delta) kept up to date one reference at a time:
+    the pages referenced in the last delta references. Each page in the set has
+    the time of its last reference, and the pages sit in a queue ordered by that
+    time, with the oldest at the tail. A reference moves its page to the head.
+    Any page whose last reference has slid out of the window is then at the
+    tail, so it is dropped there. Each page enters and leaves once per stay, so a
+    reference costs O(1) amortized and the size of the set is always known.
+    No scan of the frames is needed.
+
+    With delta 0 the window never closes by itself. Pages leave only through
+    workingSetTrim(), which is how the VSWS policy in vsws.c drops the pages not
+    used since its last sample.
+
+    Contact Information:
+    - Email: dengq@wabash.edu
+    - GitHub: github.com/QixinDeng
+
+    MIT License
+
+    Copyright (c) 2024 Your Name
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "page-policy.h"
+
+int workingSetInit(WorkingSet *ws, int capacity, long long delta) {
+    if (capacity < 1) capacity = 1;
+    ws->nodes = (WorkingSetNode *)malloc(sizeof(WorkingSetNode) * capacity);
+    if (ws->nodes == NULL) return -1;
+    if (pageIndexInit(&ws->index, capacity) < 0) {
+        free(ws->nodes);
+        ws->nodes = NULL;
+        return -1;
+    }
+    ws->capacity = capacity;
+    ws->used = 0;
+    ws->freeHead = -1;
+    ws->head = -1;
+    ws->tail = -1;
+    ws->size = 0;
+    ws->now = 0;
+    ws->delta = delta;
+    return 0;
+}
+
+static void unlinkNode(WorkingSet *ws, int node) {
+    WorkingSetNode *n = &ws->nodes[node];
+    if (n->prev != -1) ws->nodes[n->prev].next = n->next;
+    else ws->head = n->next;
+    if (n->next != -1) ws->nodes[n->next].prev = n->prev;
+    else ws->tail = n->prev;
+}
+
+static void pushHead(WorkingSet *ws, int node) {
+    ws->nodes[node].prev = -1;
+    ws->nodes[node].next = ws->head;
+    if (ws->head != -1) ws->nodes[ws->head].prev = node;
+    ws->head = node;
+    if (ws->tail == -1) ws->tail = node;
+}
+
+static int allocateNode(WorkingSet *ws) {
+    if (ws->freeHead != -1) {
+        int node = ws->freeHead;
+        ws->freeHead = ws->nodes[node].next;
+        return node;
+    }
+    if (ws->used == ws->capacity) {
+        int capacity = ws->capacity * 2;
+        WorkingSetNode *nodes = (WorkingSetNode *)realloc(ws->nodes, sizeof(WorkingSetNode) * capacity);
+        if (nodes == NULL || pageIndexReserve(&ws->index, capacity) < 0) {
+            if (nodes != NULL) ws->nodes = nodes;
+            return -1;
+        }
+        ws->nodes = nodes;
+        ws->capacity = capacity;
+    }
+    return ws->used++;
+}
+
+int workingSetEvictOldest(WorkingSet *ws) {
+    int node = ws->tail;
+    if (node == -1) return -1;
+
+    int page = ws->nodes[node].page;
+    unlinkNode(ws, node);
+    pageIndexRemove(&ws->index, page);
+    ws->nodes[node].next = ws->freeHead;
+    ws->freeHead = node;
+    ws->size--;
+    return page;
+}
+
+int workingSetAccess(WorkingSet *ws, int page) {
+    int entered = 0;
+    int node = pageIndexFind(&ws->index, page);
+
+    if (node != -1) {
+        unlinkNode(ws, node);
+    } else {
+        node = allocateNode(ws);
+        if (node == -1) return -1;
+        ws->nodes[node].page = page;
+        pageIndexInsert(&ws->index, page, node);
+        ws->size++;
+        entered = 1;
+    }
+    ws->nodes[node].lastReference = ws->now;
+    pushHead(ws, node);
+
+    // The window is now (now - delta, now]
+    if (ws->delta > 0) workingSetTrim(ws, ws->now - ws->delta + 1);
+    ws->now++;
+    return entered;
+}
+
+int workingSetTrim(WorkingSet *ws, long long since) {
+    int dropped = 0;
+    while (ws->tail != -1 && ws->nodes[ws->tail].lastReference < since) {
+        workingSetEvictOldest(ws);
+        dropped++;
+    }
+    return dropped;
+}
+
+int workingSetContains(const WorkingSet *ws, int page) {
+    return pageIndexFind(&ws->index, page) != -1;
+}
+
+void workingSetFree(WorkingSet *ws) {
+    pageIndexFree(&ws->index);
+    free(ws->nodes);
+    ws->nodes = NULL;
+}
+
+double workingSetSeries(const int pages[], long long length, long long delta, long long every, FILE *out) {
+    WorkingSet ws;
+    double sizeSum = 0;
+
+    if (delta < 1 || every < 1) {
+        printf("The window and the output interval must be at least 1\n");
+        return -1;
+    }
+    if (workingSetInit(&ws, delta < 1024 ? (int)delta : 1024, delta) < 0) return -1;
+
+    if (out != NULL) fprintf(out, "# time wss (delta %lld)\n", delta);
+    for (long long t = 0; t < length; t++) {
+        if (workingSetAccess(&ws, pages[t]) < 0) {
+            workingSetFree(&ws);
+            return -1;
+        }
+        sizeSum += ws.size;
+        if (out != NULL && (t + 1) % every == 0) fprintf(out, "%lld %d\n", t, ws.size);
+    }
+    workingSetFree(&ws);
+    return length > 0 ? sizeSum / length : 0;
+}
+
+int workingSetDemo() {
+    int length = 3000;
+    int pages[3000];
+
+    // Three phases with localities of 5, 20 and 10 pages
+    for (int i = 0; i < length; i++) {
+        if (i < 1000) pages[i] = rand() % 5;
+        else if (i < 2000) pages[i] = 100 + rand() % 20;
+        else pages[i] = 200 + rand() % 10;
+    }
+
+    printf("Working set size every 250 references, delta = 50:\n");
+    double average = workingSetSeries(pages, length, 50, 250, stdout);
+    if (average < 0) return -1;
+    printf("Average working set size: %.2f\n", average);
+    return 0;
+}